@@ -0,0 +1,722 @@
+/**
+ * DMG APU model and mixer.
+ *
+ * This is the consumer side of the audio pipeline: it owns the sound
+ * registers, applies the writes queued by the emulated CPU at the sample of
+ * the time they were made at, using clock.h, runs the 512 Hz frame sequencer and renders the four channels into
+ * buffers of MIX_BLOCK samples, which mix.h then sums to stereo.
+ */
+
+#pragma once
+
+struct apu_s
+{
+    uint8_t reg[0x40];  /* 0xFF00-0xFF3F, only 0xFF10 and up are used */
+
+    uint16_t ch1Freq;
+    uint8_t ch1SweepCounter;
+    uint8_t ch1SweepCounterI;
+    bool ch1SweepDir;
+    uint8_t ch1SweepShift;
+    uint8_t ch1Vol;
+    uint8_t ch2Vol;
+    uint8_t ch3Vol;
+    uint8_t ch4Vol;
+    uint8_t ch1VolI;
+    uint8_t ch2VolI;
+    uint8_t ch3VolI;
+    uint8_t ch4VolI;
+    uint8_t ch1Len;
+    uint8_t ch2Len;
+    uint8_t ch3Len;
+    uint8_t ch4Len;
+    uint8_t ch1LenI;
+    uint8_t ch2LenI;
+    uint8_t ch3LenI;
+    uint8_t ch4LenI;
+    bool ch1LenOn;
+    bool ch2LenOn;
+    bool ch3LenOn;
+    bool ch4LenOn;
+    uint8_t ch1EnvCounter;
+    uint8_t ch2EnvCounter;
+    uint8_t ch4EnvCounter;
+    uint8_t ch1EnvCounterI;
+    uint8_t ch2EnvCounterI;
+    uint8_t ch4EnvCounterI;
+    bool ch1EnvDir;
+    bool ch2EnvDir;
+    bool ch4EnvDir;
+    bool ch1DAC;
+    bool ch2DAC;
+    bool ch4DAC;
+    uint16_t WAVRAM[32];
+    uint32_t idleTimer;
+
+    /* Mixer */
+    uint32_t soundChannelPos[4];  /* 16.16 fixed point, ch4 only keeps the fraction */
+    uint16_t lfsr;                /* ch4 15 bit LFSR, output is bit 0 */
+    const int16_t *PU1Table;
+    const int16_t *PU2Table;
+    uint32_t apuFrame;
+    uint8_t apuCycle;
+    int16_t chBuf[4][MIX_BLOCK];  /* Channel levels, -15 to 15 */
+    struct mix_gain_s gains;      /* From NR50, NR51, NR52, channelMask and volume */
+    uint8_t channelMask;          /* Bit n set: channel n+1 is heard */
+    uint16_t volume;              /* Of this APU in the output, 256 = full */
+
+    /* Song request sent to the producer that has not been answered yet. */
+    bool resetPending;
+    uint8_t resetSeq;
+
+    /* Frame being played, from one 60 Hz tick to the next. */
+    bool frameOpen;
+    bool frameWait;               /* Wait for the producer for the writes due */
+    bool dueKnown;                /* writeDue is that of the next event */
+    uint32_t frameSample;         /* Samples rendered since the frame started */
+    uint32_t writeDue;            /* Sample the next event is due at */
+    uint16_t writeTime;           /* Time in the frame writeDue was counted to */
+    struct clock_s writeClock;    /* M-cycles to samples */
+};
+
+
+/**
+ * Applies one write to a sound register (0x10-0x3F).
+ */
+void apu_write(struct apu_s *apu, const uint8_t reg, const uint8_t val){
+    if(reg >= 0x30){
+        apu->WAVRAM[((reg & 0x0F) << 1)] = -15 + ((val & 0xF0) >> 3);
+        apu->WAVRAM[((reg & 0x0F) << 1) + 1] = -15 + ((val & 0x0F) << 1);
+        return;
+    }
+
+    if(apu->reg[reg] != val) apu->idleTimer = 0;
+    switch(reg){
+
+        case 0x10://ch1 sweep
+            apu->reg[reg] = val;
+            apu->ch1SweepDir = (val & 0x08) >> 3;
+            apu->ch1SweepCounter = apu->ch1SweepCounterI = (val & 0x70) >> 4;
+            apu->ch1SweepShift = (val & 0x07);
+        break;
+
+        case 0x11://ch1 duty/length
+            apu->reg[reg] = val;
+            apu->ch1Len = apu->ch1LenI = 64 - (val & 0x3F);
+        break;
+
+        case 0x16://ch2 duty/length
+            apu->reg[reg] = val;
+            apu->ch2Len = apu->ch2LenI = 64 - (val & 0x3F);
+        break;
+
+        case 0x1B://ch3 length
+            apu->reg[reg] = val;
+            apu->ch3Len = apu->ch3LenI = 256 - val;
+        break;
+
+        case 0x20://ch4 length
+            apu->reg[reg] = val;
+            apu->ch4Len = apu->ch4LenI = 64 - (val & 0x3F);
+        break;
+
+        case 0x12://ch1 envelope
+            apu->reg[reg] = val;
+            apu->ch1DAC = (val & 0xF8) > 0;
+            apu->ch1Vol = apu->ch1VolI = (val & 0xF0) >> 4;
+            apu->ch1EnvDir = (val & 0x08) >> 3;
+            apu->ch1EnvCounter = apu->ch1EnvCounterI = (val & 0x07);
+        break;
+
+        case 0x17://ch2 envelope
+            apu->reg[reg] = val;
+            apu->ch2DAC = (val & 0xF8) > 0;
+            apu->ch2Vol = apu->ch2VolI = (val & 0xF0) >> 4;
+            apu->ch2EnvDir = (val & 0x08) >> 3;
+            apu->ch2EnvCounter = apu->ch2EnvCounterI = (val & 0x07);
+        break;
+
+        case 0x1C://ch3 Volume (on hardware, this bitshifts the wav samples. The method here is quicker, sounds better, but is less accurate compared to hardware)
+            apu->reg[reg] = val;
+            switch((val & 0x60)){
+                case 0x00://mute
+                    apu->ch3Vol = apu->ch3VolI = 8;
+                break;
+                case 0x20://full
+                    apu->ch3Vol = apu->ch3VolI = 0;
+                break;
+                case 0x40://half
+                    apu->ch3Vol = apu->ch3VolI = 2;
+                break;
+                case 0x60://quarter
+                    apu->ch3Vol = apu->ch3VolI = 3;
+                break;
+            }
+
+        break;
+
+        case 0x21://ch4 envelope
+            apu->reg[reg] = val;
+            apu->ch4DAC = (val & 0xF8) > 0;
+            apu->ch4Vol = apu->ch4VolI = (val & 0xF0) >> 4;
+            apu->ch4EnvDir = (val & 0x08) >> 3;
+            apu->ch4EnvCounter = apu->ch4EnvCounterI = (val & 0x07);
+        break;
+
+        case 0x14://ch1 retrigger sound
+            apu->reg[reg] = val;
+            if(val&0x80){
+                apu->ch1Vol = apu->ch1VolI;
+                if(apu->ch1DAC) apu->reg[0x26] |= 0x01;
+                apu->ch1SweepCounter = apu->ch1SweepCounterI;
+                apu->ch1EnvCounter = apu->ch1EnvCounterI;
+                apu->ch1Len = apu->ch1LenI;
+            }
+            if(val&0x40){
+                apu->ch1LenOn = 1;
+            }else{
+                apu->ch1LenOn = 0;
+            }
+        break;
+
+        case 0x19://ch2 retrigger sound
+            apu->reg[reg] = val;
+            if(val&0x80){
+                apu->ch2Vol = apu->ch2VolI;
+                if(apu->ch2DAC) apu->reg[0x26] |= 0x02;
+                apu->ch2EnvCounter = apu->ch2EnvCounterI;
+                apu->ch2Len = apu->ch2LenI;
+            }
+            if(val&0x40){
+                apu->ch2LenOn = 1;
+            }else{
+                apu->ch2LenOn = 0;
+            }
+        break;
+
+        case 0x1E://ch3 retrigger sound
+            apu->reg[reg] = val;
+            if(val&0x80){
+                apu->ch3Vol = apu->ch3VolI;
+                if(apu->reg[0x1A] & 0x80) apu->reg[0x26] |= 0x04;
+                apu->ch3Len = apu->ch3LenI;
+            }
+            if(val&0x40){
+                apu->ch3LenOn = 1;
+            }else{
+                apu->ch3LenOn = 0;
+            }
+        break;
+
+        case 0x23://ch4 retrigger sound
+            apu->reg[reg] = val;
+            if(val&0x80){
+                apu->ch4Vol = apu->ch4VolI;
+                //if(apu->ch4DAC)
+                apu->reg[0x26] |= 0x08;
+                apu->lfsr = 0x7FFF;
+                apu->ch4EnvCounter = apu->ch4EnvCounterI;
+                apu->ch4Len = apu->ch4LenI;
+            }
+            if(val&0x40){
+                apu->ch4LenOn = 1;
+            }else{
+                apu->ch4LenOn = 0;
+            }
+        break;
+
+        default: apu->reg[reg] = (val & APU_WRITE_MASK[reg]) + (apu->reg[reg] & (APU_WRITE_MASK[reg]^0xFF)); break;
+    }
+}
+
+
+/**
+ * Works out the mix gains from NR51 (which channels go to which side), NR50
+ * (master volume per side), the NR52 power bit, the channel mask and the
+ * volume. Side 0 takes the low nibble of NR51 and the low bits of NR50.
+ * Called whenever one of those may have changed, so the mixer never tests
+ * them itself.
+ */
+void apu_update_gains(struct apu_s *apu){
+    uint8_t on = (apu->reg[0x26] & 0x80) ? apu->channelMask : 0;
+    int16_t left = ((((apu->reg[0x24] & 0x07) + 1) << 5) * apu->volume) >> 8;
+    int16_t right = (((((apu->reg[0x24] >> 4) & 0x07) + 1) << 5) * apu->volume) >> 8;
+
+    for(int c = 0; c < 4; c++){
+        apu->gains.gain[0][c] = (on & apu->reg[0x25] & (0x01 << c)) ? left : 0;
+        apu->gains.gain[1][c] = ((on << 4) & apu->reg[0x25] & (0x10 << c)) ? right : 0;
+    }
+    mix_gain_update(&apu->gains);
+}
+
+
+/**
+ * Sets which channels are heard: bit n for channel n+1, so 0x0F plays
+ * all of them and 1 << n solos one. Stays set across songs.
+ */
+void apu_set_channel_mask(struct apu_s *apu, uint8_t mask){
+    apu->channelMask = mask & 0x0F;
+    apu_update_gains(apu);
+}
+
+
+/**
+ * Sets how loud this APU is in the output, 256 being full volume. Used to
+ * balance several APUs mixed together. At most 512, so the mix of one APU
+ * still fits in 16 bits.
+ */
+void apu_set_volume(struct apu_s *apu, uint16_t volume){
+    apu->volume = volume > 512 ? 512 : volume;
+    apu_update_gains(apu);
+}
+
+
+/**
+ * Puts the APU into its power-on state for a new song.
+ */
+void apu_reset(struct apu_s *apu){
+    for(uint8_t i = 0; i < 0x20; i++) apu_write(apu, 0x10 + i, APU_INIT_REGS[i]);
+
+    for(int i = 0; i < 0x20; i++) apu->WAVRAM[i] = 0;
+    apu->ch1Freq = 0;
+    apu->ch1SweepCounter = 0;
+    apu->ch1SweepCounterI = 0;
+    apu->ch1SweepDir = 0;
+    apu->ch1SweepShift = 0;
+    apu->ch1Vol = apu->ch2Vol = apu->ch3Vol = apu->ch4Vol = 0;
+    apu->ch1VolI = apu->ch2VolI = apu->ch3VolI = apu->ch4VolI = 0;
+    apu->ch1Len = apu->ch2Len = apu->ch3Len = apu->ch4Len = 0;
+    apu->ch1LenI = apu->ch2LenI = apu->ch3LenI = apu->ch4LenI = 0;
+    apu->ch1LenOn = apu->ch2LenOn = apu->ch3LenOn = apu->ch4LenOn = 0;
+    apu->ch1EnvCounter = apu->ch2EnvCounter = apu->ch4EnvCounter = 0;
+    apu->ch1EnvCounterI = apu->ch2EnvCounterI = apu->ch4EnvCounterI = 0;
+    apu->ch1EnvDir = apu->ch2EnvDir = apu->ch4EnvDir = 0;
+    apu->ch1DAC = apu->ch2DAC = apu->ch4DAC = 0;
+    apu->idleTimer = 0;
+
+    apu->soundChannelPos[0] = 0;
+    apu->soundChannelPos[1] = 0x0290;  /* 0.01 */
+    apu->soundChannelPos[2] = 0;
+    apu->soundChannelPos[3] = 0;
+    apu->lfsr = 0x7FFF;
+    apu->apuFrame = SAMPLE_RATE;
+    apu->apuCycle = 0;
+    apu_update_gains(apu);
+}
+
+
+/**
+ * Clears the whole APU context. Called once before the first song.
+ */
+void apu_init(struct apu_s *apu){
+    for(int i = 0; i < 0x40; i++) apu->reg[i] = 0;
+    apu->PU1Table = PU0;
+    apu->PU2Table = PU0;
+    apu->resetPending = 0;
+    apu->frameOpen = 0;
+    apu->channelMask = 0x0F;
+    apu->volume = 256;
+    apu_reset(apu);
+}
+
+
+/**
+ * Asks the producer to start a song. Frames still queued for the old song
+ * are dropped until the producer answers with the matching reset.
+ */
+void apu_request_song(struct apu_s *apu, struct reg_queue_s *q, uint8_t song){
+    apu->resetSeq = reg_queue_request_song(q, song) & 0xFF;
+    apu->resetPending = 1;
+    /* The rest of the frame being played is dropped with what follows it. */
+    apu->frameOpen = 0;
+}
+
+
+/**
+ * Drops what is queued ahead of the answer to a song request, without
+ * waiting, so the producer has room to run the new song ahead of when it is
+ * played: its init routine and first frames are then emulated in the
+ * background. The new song's writes stay queued for apu_consume_frame.
+ * Returns true once the APU has been reset for the new song.
+ */
+bool apu_preroll(struct apu_s *apu, struct reg_queue_s *q){
+    uint32_t event;
+
+    while(apu->resetPending && reg_queue_event_ready(q)){
+        event = reg_queue_pop(q);
+        if(REG_EVENT_REG(event) == REG_EVENT_FRAME){
+            reg_queue_frame_done(q);
+        }else if(REG_EVENT_REG(event) == REG_EVENT_RESET && REG_EVENT_VAL(event) == apu->resetSeq){
+            apu->resetPending = 0;
+            apu_reset(apu);
+        }
+    }
+    return !apu->resetPending;
+}
+
+
+/**
+ * Applies one event popped from the queue, other than a frame marker.
+ */
+static void apu_event(struct apu_s *apu, uint32_t event){
+    if(REG_EVENT_REG(event) == REG_EVENT_RESET){
+        if(apu->resetPending && REG_EVENT_VAL(event) == apu->resetSeq){
+            apu->resetPending = 0;
+            apu_reset(apu);
+        }
+    }else if(!apu->resetPending){
+        apu_write(apu, REG_EVENT_REG(event), REG_EVENT_VAL(event));
+    }
+}
+
+
+/**
+ * Brings what is derived from the registers up to date, once writes have
+ * been applied: the mix gains and the duty tables.
+ */
+static void apu_writes_applied(struct apu_s *apu){
+    apu_update_gains(apu);
+
+    switch(apu->reg[0x11] & 0xC0){
+        case 0x00:
+            apu->PU1Table = PU0;
+        break;
+        case 0x40:
+            apu->PU1Table = PU1;
+        break;
+        case 0x80:
+            apu->PU1Table = PU2;
+        break;
+        case 0xC0:
+            apu->PU1Table = PU3;
+        break;
+    }
+
+    switch(apu->reg[0x16] & 0xC0){
+        case 0x00:
+            apu->PU2Table = PU0;
+        break;
+        case 0x40:
+            apu->PU2Table = PU1;
+        break;
+        case 0x80:
+            apu->PU2Table = PU2;
+        break;
+        case 0xC0:
+            apu->PU2Table = PU3;
+        break;
+    }
+}
+
+
+/**
+ * True if the next frame is all queued, past the one being played.
+ */
+bool apu_frame_ready(struct apu_s *apu, struct reg_queue_s *q){
+    return reg_queue_frames_ready(q) > apu->frameOpen;
+}
+
+
+/**
+ * Ends the frame being played at a 60 Hz tick and starts the next: what is
+ * left of the old one is applied at once, and the writes of the new one
+ * are then applied by apu_apply_writes at the sample of their time. If wait
+ * is false and the producer has not finished the next frame yet, it is not
+ * started and false is returned, unless the producer has stopped for room
+ * partway through it: then it is started with the writes made so far, and
+ * the rest are applied as they come in.
+ */
+bool apu_consume_frame(struct apu_s *apu, struct reg_queue_s *q, bool wait){
+    uint32_t event;
+
+    apu->frameWait = wait;
+    apu->dueKnown = 0;
+
+    while(apu->frameOpen){
+        if(!wait && !reg_queue_event_ready(q)){
+            /* Still not finished, the rest comes in late */
+            apu_writes_applied(apu);
+            return false;
+        }
+
+        event = reg_queue_pop(q);
+        if(REG_EVENT_REG(event) == REG_EVENT_FRAME){
+            reg_queue_frame_done(q);
+            apu->frameOpen = 0;
+        }else{
+            apu_event(apu, event);
+        }
+    }
+
+    /* Up to the answer to a song request, what is queued is dropped. */
+    while(apu->resetPending && (wait || reg_queue_event_ready(q))){
+        event = reg_queue_pop(q);
+        if(REG_EVENT_REG(event) == REG_EVENT_FRAME)
+            reg_queue_frame_done(q);
+        else
+            apu_event(apu, event);
+    }
+
+    if(apu->resetPending || (!reg_queue_frame_ready(q) && !reg_queue_stalled(q))){
+        if(!wait){
+            apu_writes_applied(apu);
+            return false;
+        }
+        while(!reg_queue_frame_ready(q) && !reg_queue_stalled(q))
+            REG_QUEUE_IDLE();
+    }
+
+    apu->frameOpen = 1;
+    apu->frameSample = 0;
+    apu->writeDue = 0;
+    apu->writeTime = 0;
+    clock_init(&apu->writeClock, CLOCK_GB_HZ / 4, SAMPLE_RATE);
+    apu_writes_applied(apu);
+    return true;
+}
+
+
+/**
+ * True if an event of the frame being played is due before the next sample
+ * is rendered. Writes are due at the sample of their time in the frame, the
+ * frame marker only at the next 60 Hz tick.
+ */
+static inline bool apu_write_due(struct apu_s *apu, struct reg_queue_s *q){
+    uint32_t event;
+
+    if(!apu->frameOpen)
+        return false;
+
+    if(!apu->dueKnown){
+        if(!reg_queue_event_ready(q)){
+            if(!apu->frameWait)
+                return false;
+            while(!reg_queue_event_ready(q))
+                REG_QUEUE_IDLE();
+        }
+
+        event = reg_queue_peek(q);
+        if(REG_EVENT_REG(event) == REG_EVENT_FRAME){
+            apu->writeDue = UINT32_MAX;
+        }else if(REG_EVENT_TIME(event) > apu->writeTime){
+            apu->writeDue += clock_step(&apu->writeClock, REG_EVENT_TIME(event) - apu->writeTime);
+            apu->writeTime = REG_EVENT_TIME(event);
+        }
+        apu->dueKnown = 1;
+    }
+    return apu->writeDue <= apu->frameSample;
+}
+
+
+/**
+ * Applies the writes that are due before the next sample is rendered.
+ */
+void apu_apply_writes(struct apu_s *apu, struct reg_queue_s *q){
+    if(!apu_write_due(apu, q))
+        return;
+
+    do{
+        apu_event(apu, reg_queue_pop(q));
+        apu->dueKnown = 0;
+    }while(apu_write_due(apu, q));
+    apu_writes_applied(apu);
+}
+
+
+/**
+ * Runs the 512 Hz frame sequencer (length, envelope and sweep) if it is due.
+ */
+void apu_frame_sequencer(struct apu_s *apu){
+    apu->apuFrame += 512;
+    if(apu->apuFrame < SAMPLE_RATE)
+        return;
+
+    apu->apuFrame -= SAMPLE_RATE;
+    apu->apuCycle++;
+
+    if((apu->apuCycle & 1) == 0){  // Length
+        if(apu->ch1Len){
+            if(--apu->ch1Len == 0 && apu->ch1LenOn){
+                apu->reg[0x26] &= 0xFE;
+            }
+        }
+
+        if(apu->ch2Len){
+            if(--apu->ch2Len == 0 && apu->ch2LenOn){
+                apu->reg[0x26] &= 0xFD;
+            }
+        }
+
+        if(apu->ch3Len){
+            if(--apu->ch3Len == 0 && apu->ch3LenOn){
+                apu->reg[0x26] &= 0xFB;
+            }
+        }
+
+        if(apu->ch4Len){
+            if(--apu->ch4Len == 0 && apu->ch4LenOn){
+                apu->reg[0x26] &= 0xF7;
+            }
+        }
+    }
+
+    if((apu->apuCycle & 7) == 7){  // Envelope
+        if(apu->ch1EnvCounter){
+            if(--apu->ch1EnvCounter == 0){
+                if(apu->ch1Vol && !apu->ch1EnvDir){
+                    apu->ch1Vol--;
+                    apu->ch1EnvCounter = apu->ch1EnvCounterI;
+                }else if(apu->ch1Vol < 0x0F && apu->ch1EnvDir){
+                    apu->ch1Vol++;
+                    apu->ch1EnvCounter = apu->ch1EnvCounterI;
+                }
+            }
+        }
+
+        if(apu->ch2EnvCounter){
+            if(--apu->ch2EnvCounter == 0){
+                if(apu->ch2Vol && !apu->ch2EnvDir){
+                    apu->ch2Vol--;
+                    apu->ch2EnvCounter = apu->ch2EnvCounterI;
+                }else if(apu->ch2Vol < 0x0F && apu->ch2EnvDir){
+                    apu->ch2Vol++;
+                    apu->ch2EnvCounter = apu->ch2EnvCounterI;
+                }
+            }
+        }
+
+        if(apu->ch4EnvCounter){
+            if(--apu->ch4EnvCounter == 0){
+                if(apu->ch4Vol && !apu->ch4EnvDir){
+                    apu->ch4Vol--;
+                    apu->ch4EnvCounter = apu->ch4EnvCounterI;
+                }else if(apu->ch4Vol < 0x0F && apu->ch4EnvDir){
+                    apu->ch4Vol++;
+                    apu->ch4EnvCounter = apu->ch4EnvCounterI;
+                }
+            }
+        }
+    }
+
+    if((apu->apuCycle & 3) == 2){  // Sweep
+        if(apu->ch1SweepCounterI && apu->ch1SweepShift){
+            if(--apu->ch1SweepCounter == 0){
+                apu->ch1Freq = apu->reg[0x13] + ((apu->reg[0x14] & 7) << 8);
+                if(apu->ch1SweepDir){
+                    apu->ch1Freq -= apu->ch1Freq >> apu->ch1SweepShift;
+                    if(apu->ch1Freq & 0xF800) apu->ch1Freq = 0;
+                }else{
+                    apu->ch1Freq += apu->ch1Freq >> apu->ch1SweepShift;
+                    if(apu->ch1Freq & 0xF800){
+                        apu->ch1Freq = 0;
+                        apu->ch1EnvCounter = 0;
+                        apu->ch1Vol = 0;
+                    }
+                }
+                apu->reg[0x13] = apu->ch1Freq & 0xFF;
+                apu->reg[0x14] &= 0xF8;
+                apu->reg[0x14] += (apu->ch1Freq >> 8) & 0x07;
+                apu->ch1SweepCounter = apu->ch1SweepCounterI;
+            }
+        }
+    }
+}
+
+
+/**
+ * Clocks the noise LFSR as many times as the noise clock ticked during one
+ * output sample and returns the channel's level, the average of the bits it
+ * put out. Up to 14 steps (6 in 7 bit mode) are done at once: the bits
+ * shifted out are the low bits of the register, and the bits fed back in
+ * are those bits XORed with their upper neighbours.
+ */
+int16_t apu_noise(struct apu_s *apu){
+    uint32_t steps, n, mask, fb, ones = 0;
+    uint16_t lfsr = apu->lfsr;
+    int16_t level;
+
+    apu->soundChannelPos[3] += freqTableNSE[apu->reg[0x22]];
+    steps = apu->soundChannelPos[3] >> 16;
+    apu->soundChannelPos[3] &= 0xFFFF;
+    if(!steps) return (lfsr & 1) ? apu->ch4Vol : -apu->ch4Vol;
+
+    for(uint32_t left = steps; left; left -= n){
+        n = (apu->reg[0x22] & 0x08) ? 6 : 14;
+        if(n > left) n = left;
+        mask = (1 << n) - 1;
+        ones += __builtin_popcount(lfsr & mask);
+        fb = (lfsr ^ (lfsr >> 1)) & mask;
+        lfsr = (lfsr >> n) | (fb << (15 - n));
+        if(apu->reg[0x22] & 0x08) lfsr = (lfsr & ~(mask << (7 - n))) | (fb << (7 - n));
+    }
+    apu->lfsr = lfsr;
+
+    level = apu->ch4Vol * (int16_t)(2 * ones - steps);
+    return steps == 1 ? level : level / (int16_t)steps;
+}
+
+
+/**
+ * Renders sample i of the block into the channel buffers.
+ */
+void apu_sample(struct apu_s *apu, uint32_t i){
+    int16_t noise;
+
+    apu_frame_sequencer(apu);
+
+    //Sound generation loop
+    apu->soundChannelPos[0] = (apu->soundChannelPos[0] + freqTable[apu->reg[0x13]+((apu->reg[0x14]&7)<<8)]) & 0x1FFFFF;
+    apu->soundChannelPos[1] = (apu->soundChannelPos[1] + freqTable[apu->reg[0x18]+((apu->reg[0x19]&7)<<8)]) & 0x1FFFFF;
+    apu->soundChannelPos[2] = (apu->soundChannelPos[2] + freqTable[apu->reg[0x1D]+((apu->reg[0x1E]&7)<<8)]) & 0x1FFFFF;
+    noise = apu_noise(apu);
+    // Channels that are not mixed are not rendered either, see apu_update_gains
+    for(int k = 0; k < apu->gains.count; k++){
+        switch(apu->gains.channel[k]){
+            case 0:
+                apu->chBuf[0][i] = ((apu->ch1DAC) && (apu->reg[0x26] & 0x01)) ? apu->ch1Vol * apu->PU1Table[apu->soundChannelPos[0] >> 16] : 0;
+            break;
+            case 1:
+                apu->chBuf[1][i] = ((apu->ch2DAC) && (apu->reg[0x26] & 0x02)) ? apu->ch2Vol * apu->PU2Table[apu->soundChannelPos[1] >> 16] : 0;
+            break;
+            case 2:
+                apu->chBuf[2][i] = ((apu->reg[0x1A] & 0x80) && (apu->reg[0x26] & 0x04)) ? apu->WAVRAM[apu->soundChannelPos[2] >> 16] >> apu->ch3Vol : 0;
+            break;
+            case 3:
+                apu->chBuf[3][i] = ((apu->ch4DAC) && (apu->reg[0x26] & 0x08)) ? noise : 0;
+            break;
+        }
+    }
+    apu->idleTimer++;
+    apu->frameSample++;
+}
+
+
+/**
+ * Mixes samples from to to-1 of the channel buffers and adds them to acc,
+ * interleaved stereo with acc[0] being sample from. One step of the 8 bit
+ * output is 256; mix_to_s8() makes the output of the sum.
+ */
+void apu_mix(struct apu_s *apu, uint32_t from, uint32_t to, int32_t *acc){
+    const int16_t *const ch[4] = {&apu->chBuf[0][from], &apu->chBuf[1][from], &apu->chBuf[2][from], &apu->chBuf[3][from]};
+    int16_t mixed[MIX_BLOCK * 2];
+
+    mix_kernel(mixed, ch, &apu->gains, to - from);
+    for(uint32_t i = 0; i < (to - from) * 2; i++) acc[i] += mixed[i];
+}
+
+
+/**
+ * Like apu_mix, but for channel c alone: the stem that channel adds to the
+ * mix, with its side routing and volume.
+ */
+void apu_mix_channel(struct apu_s *apu, int c, uint32_t from, uint32_t to, int32_t *acc){
+    const int16_t *const ch[4] = {&apu->chBuf[0][from], &apu->chBuf[1][from], &apu->chBuf[2][from], &apu->chBuf[3][from]};
+    struct mix_gain_s gains = {0};
+    int16_t mixed[MIX_BLOCK * 2];
+
+    gains.gain[0][c] = apu->gains.gain[0][c];
+    gains.gain[1][c] = apu->gains.gain[1][c];
+    mix_gain_update(&gains);
+    mix_kernel(mixed, ch, &gains, to - from);
+    for(uint32_t i = 0; i < (to - from) * 2; i++) acc[i] += mixed[i];
+}
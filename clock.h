@@ -0,0 +1,60 @@
+/**
+ * Exact conversion from one clock to another, such as output samples to
+ * 60 Hz frames, or frames to emulated T-cycles.
+ *
+ * The ratio is kept as the two rates rather than rounded to a step, and the
+ * remainder is carried from one call to the next, so that after any number
+ * of ticks of the first clock the second has moved on by exactly the whole
+ * ticks it should have: frame n always starts on T-cycle
+ * n * CLOCK_GB_HZ / CLOCK_FRAME_HZ, rounded down, however long it has run.
+ */
+
+#pragma once
+
+#define CLOCK_GB_HZ     4194304 /* DMG T-cycles per second */
+#define CLOCK_FRAME_HZ  60      /* Frames of APU writes, see reg_queue.h */
+
+struct clock_s
+{
+    uint32_t from_hz;
+    uint32_t to_hz;
+    uint32_t acc;   /* Remainder, in from_hz ticks times to_hz */
+};
+
+
+/**
+ * Starts a clock that turns ticks at from_hz into ticks at to_hz. n ticks
+ * times to_hz, plus from_hz, must fit in 32 bits for every step taken.
+ */
+void clock_init(struct clock_s *c, uint32_t from_hz, uint32_t to_hz){
+    c->from_hz = from_hz;
+    c->to_hz = to_hz;
+    c->acc = 0;
+}
+
+/**
+ * Starts a clock like clock_init, but with a tick at to_hz due at once, for
+ * when a tick is the moment something starts rather than ends: each step
+ * then counts the ticks that start within it. to_hz must not be above
+ * from_hz.
+ */
+void clock_init_due(struct clock_s *c, uint32_t from_hz, uint32_t to_hz){
+    clock_init(c, from_hz, to_hz);
+    c->acc = from_hz - to_hz;
+}
+
+/**
+ * Moves the clock on by n ticks at from_hz. Returns the whole ticks at
+ * to_hz that they make up, with what is left over carried to the next call.
+ */
+static inline uint32_t clock_step(struct clock_s *c, uint32_t n){
+    uint32_t ticks;
+
+    c->acc += n * c->to_hz;
+    if(c->acc < c->from_hz)
+        return 0;
+
+    ticks = c->acc / c->from_hz;
+    c->acc -= ticks * c->from_hz;
+    return ticks;
+}
@@ -0,0 +1,147 @@
+/**
+ * One GBS engine: the emulated CPU, its APU and the queue between them.
+ * Several engines can run side by side (music plus sound effects, or two
+ * tracks to crossfade); every one is produced and consumed in the same
+ * 60 Hz steps, and their mixes are summed, each at its own volume.
+ */
+
+#pragma once
+
+struct engine_s
+{
+    struct gb_s gb;
+    struct apu_s apu;
+    struct reg_queue_s queue;
+};
+
+
+/**
+ * Sets up an engine to play a GBS file. The data is used in place and the
+ * engine must have been zeroed. Returns the number of songs, or 0 if this
+ * is not a GBS file.
+ */
+uint8_t engine_load(struct engine_s *e, const uint8_t *gbs, uint32_t size, struct stats_s *stats){
+    uint8_t songs = gb_load_gbs(&e->gb, gbs, size);
+
+    reg_queue_init(&e->queue);
+    e->gb.apu_queue = &e->queue;
+    e->gb.stats = stats;
+    apu_init(&e->apu);
+    return songs;
+}
+
+/**
+ * Producer: emulates one frame on each engine that has room for it.
+ * Returns 0 if there was nothing to do.
+ */
+int engine_produce(struct engine_s *e, uint32_t count){
+    int busy = 0;
+
+    for(uint32_t i = 0; i < count; i++) busy |= gb_produce(&e[i].gb);
+    return busy;
+}
+
+/**
+ * Consumer: applies the next frame of writes on every engine. Returns false
+ * if any of them had no frame ready (and wait is false).
+ */
+bool engine_consume_frame(struct engine_s *e, uint32_t count, bool wait){
+    bool ready = true;
+
+    for(uint32_t i = 0; i < count; i++) ready &= apu_consume_frame(&e[i].apu, &e[i].queue, wait);
+    return ready;
+}
+
+/**
+ * Consumer: lets every engine run its next song ahead, see apu_preroll.
+ * Returns true once all of them have started it.
+ */
+bool engine_preroll(struct engine_s *e, uint32_t count){
+    bool started = true;
+
+    for(uint32_t i = 0; i < count; i++) started &= apu_preroll(&e[i].apu, &e[i].queue);
+    return started;
+}
+
+/**
+ * Consumer: true if any engine has writes due before the next sample, see
+ * apu_write_due. The mix up to here is then made with the gains as they
+ * were, before engine_apply_writes changes them.
+ */
+bool engine_write_due(struct engine_s *e, uint32_t count){
+    bool due = false;
+
+    for(uint32_t i = 0; i < count; i++) due |= apu_write_due(&e[i].apu, &e[i].queue);
+    return due;
+}
+
+/**
+ * Consumer: applies the writes due before the next sample on every engine.
+ */
+void engine_apply_writes(struct engine_s *e, uint32_t count){
+    for(uint32_t i = 0; i < count; i++) apu_apply_writes(&e[i].apu, &e[i].queue);
+}
+
+/**
+ * Consumer: renders sample i of the block on every engine.
+ */
+void engine_sample(struct engine_s *e, uint32_t count, uint32_t i){
+    for(uint32_t k = 0; k < count; k++) apu_sample(&e[k].apu, i);
+}
+
+/**
+ * Consumer: mixes samples from to to-1 of every engine into 8 bit stereo
+ * at out (out[0] is sample from), through fade if it is not NULL.
+ */
+void engine_mix(struct engine_s *e, uint32_t count, uint32_t from, uint32_t to, struct fade_s *fade, int8_t *out){
+    int32_t acc[MIX_BLOCK * 2] = {0};
+
+    for(uint32_t i = 0; i < count; i++) apu_mix(&e[i].apu, from, to, acc);
+    if(fade) fade_apply(fade, acc, to - from);
+    mix_to_s8(acc, out, (to - from) * 2);
+}
+
+
+/**
+ * Plays seconds of a song on one engine, on the calling core only, and
+ * measures what it costs each side of the queue. The results are in
+ * STATS_NOW ticks per second of audio; how many engines fit in realtime is
+ * the tick rate over the higher of the two (the filter and resampler run
+ * once for all engines and are not counted).
+ */
+void engine_benchmark(struct engine_s *e, uint8_t song, uint32_t seconds, uint32_t *producerTicks, uint32_t *consumerTicks){
+    uint64_t produced = 0, consumed = 0;
+    int8_t out[MIX_BLOCK * 2];
+    uint32_t start;
+    bool started;
+
+    apu_request_song(&e->apu, &e->queue, song);
+    for(uint32_t frame = 0; frame < seconds * 60; frame++){
+        /* A frame that stops for room is started with what of it is
+         * queued. If it stopped before the last frame was ended, ending
+         * that makes room, and the producer has a second go. */
+        for(uint32_t tries = 0; tries < 2; tries++){
+            start = STATS_NOW();
+            while(!apu_frame_ready(&e->apu, &e->queue) && gb_produce(&e->gb));
+            produced += (STATS_NOW() - start) & STATS_TICK_MASK;
+
+            start = STATS_NOW();
+            started = apu_consume_frame(&e->apu, &e->queue, false);
+            consumed += (STATS_NOW() - start) & STATS_TICK_MASK;
+            if(started) break;
+        }
+
+        start = STATS_NOW();
+        for(uint32_t i = 0; i < SAMPLE_RATE / 60; i += MIX_BLOCK){
+            uint32_t n = SAMPLE_RATE / 60 - i < MIX_BLOCK ? SAMPLE_RATE / 60 - i : MIX_BLOCK;
+            for(uint32_t k = 0; k < n; k++){
+                apu_apply_writes(&e->apu, &e->queue);
+                apu_sample(&e->apu, k);
+            }
+            engine_mix(e, 1, 0, n, NULL, out);
+        }
+        consumed += (STATS_NOW() - start) & STATS_TICK_MASK;
+    }
+    *producerTicks = produced / seconds;
+    *consumerTicks = consumed / seconds;
+}
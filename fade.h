@@ -0,0 +1,119 @@
+/**
+ * Gain ramps applied in the block mixer, for fading songs out (or in).
+ *
+ * The gain is worked out for every sample, so a ramp has no steps in it
+ * whatever its length. It is all fixed point: gains are 12 bit fractions,
+ * the position within a ramp a 32 bit fraction advanced by a step
+ * computed once when the ramp starts. The curves other than linear come
+ * from 65 point tables, interpolated between points.
+ */
+
+#pragma once
+
+#define FADE_SHIFT  12
+#define FADE_UNITY  (1 << FADE_SHIFT)
+
+enum fade_curve
+{
+    FADE_LINEAR,        /* Straight line in amplitude */
+    FADE_EQUAL_POWER,   /* Quarter sine, for crossfades that keep the loudness */
+    FADE_EXPONENTIAL,   /* Straight line in dB, from -60 dB; sounds even to the ear */
+};
+
+struct fade_s
+{
+    uint16_t gain;      /* Now, FADE_UNITY = full */
+    uint16_t from, to;  /* Ramp ends */
+    uint8_t curve;
+    uint32_t pos;       /* Through the ramp, 0.32 */
+    uint32_t step;      /* Per sample */
+    uint32_t remaining; /* Samples until the ramp ends, 0 = none going */
+};
+
+/* Rising curves from 0 to FADE_UNITY; falling ramps run them backwards */
+static const uint16_t FADE_EQUAL_POWER_TABLE[65] = {
+       0,  101,  201,  301,  401,  501,  601,  700,  799,  897,  995, 1092, 1189,
+    1285, 1380, 1474, 1567, 1660, 1751, 1842, 1931, 2019, 2106, 2191, 2276, 2359,
+    2440, 2520, 2598, 2675, 2751, 2824, 2896, 2967, 3035, 3102, 3166, 3229, 3290,
+    3349, 3406, 3461, 3513, 3564, 3612, 3659, 3703, 3745, 3784, 3822, 3857, 3889,
+    3920, 3948, 3973, 3996, 4017, 4036, 4052, 4065, 4076, 4085, 4091, 4095, 4096
+};
+static const uint16_t FADE_EXPONENTIAL_TABLE[65] = {
+       0,    5,    5,    6,    6,    7,    8,    9,   10,   11,   12,   13,   15,
+      17,   19,   21,   23,   26,   29,   32,   35,   40,   44,   49,   55,   61,
+      68,   76,   84,   94,  104,  116,  130,  144,  161,  179,  199,  222,  248,
+     276,  307,  342,  381,  425,  473,  527,  587,  654,  728,  811,  904, 1007,
+    1122, 1249, 1392, 1551, 1727, 1924, 2143, 2388, 2660, 2963, 3301, 3677, 4096
+};
+
+
+/**
+ * Sets the gain to full, with no ramp going.
+ */
+void fade_init(struct fade_s *f){
+    f->gain = f->from = f->to = FADE_UNITY;
+    f->curve = FADE_LINEAR;
+    f->pos = 0;
+    f->step = 0;
+    f->remaining = 0;
+}
+
+/**
+ * Starts a ramp from the gain now to gain to (at most FADE_UNITY), over
+ * samples samples. 0 samples sets the gain straight away.
+ */
+void fade_start(struct fade_s *f, uint16_t to, uint32_t samples, enum fade_curve curve){
+    if(to > FADE_UNITY) to = FADE_UNITY;
+    f->from = f->gain;
+    f->to = to;
+    f->curve = curve;
+    f->pos = 0;
+    f->step = samples ? 0xFFFFFFFFu / samples : 0;
+    f->remaining = samples;
+    if(!samples) f->gain = to;
+}
+
+/**
+ * True once a ramp has taken the gain down to 0.
+ */
+bool fade_silent(const struct fade_s *f){
+    return !f->remaining && !f->gain;
+}
+
+
+static inline uint16_t fade_curve_at(uint8_t curve, uint32_t x){
+    const uint16_t *t = curve == FADE_EQUAL_POWER ? FADE_EQUAL_POWER_TABLE : FADE_EXPONENTIAL_TABLE;
+    uint32_t i = x >> 26, frac = (x >> 14) & (FADE_UNITY - 1);
+
+    if(curve == FADE_LINEAR)
+        return x >> (32 - FADE_SHIFT);
+    return t[i] + (((t[i + 1] - t[i]) * frac) >> FADE_SHIFT);
+}
+
+/**
+ * Applies the gain to frames of interleaved stereo in acc (see apu_mix),
+ * moving the ramp on by as many samples.
+ */
+void fade_apply(struct fade_s *f, int32_t *acc, uint32_t frames){
+    uint32_t i = 0;
+
+    for(; i < frames && f->remaining; i++){
+        f->pos += f->step;
+        if(--f->remaining == 0){
+            f->gain = f->to;
+        }else if(f->to < f->from){
+            f->gain = f->to + (((f->from - f->to) * fade_curve_at(f->curve, ~f->pos)) >> FADE_SHIFT);
+        }else{
+            f->gain = f->from + (((f->to - f->from) * fade_curve_at(f->curve, f->pos)) >> FADE_SHIFT);
+        }
+        acc[i * 2] = (acc[i * 2] * f->gain) >> FADE_SHIFT;
+        acc[i * 2 + 1] = (acc[i * 2 + 1] * f->gain) >> FADE_SHIFT;
+    }
+
+    // The rest of the block at a steady gain
+    if(f->gain == FADE_UNITY) return;
+    for(; i < frames; i++){
+        acc[i * 2] = (acc[i * 2] * f->gain) >> FADE_SHIFT;
+        acc[i * 2 + 1] = (acc[i * 2 + 1] * f->gain) >> FADE_SHIFT;
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * Output filter stage, run over each mixed block before it is played.
+ *
+ * A one-pole high-pass removes DC like the capacitor on the DMG's output
+ * does, so channels switching on and off no longer pop, and a one-pole
+ * low-pass stands in for the reconstruction filter the PWM output lacks.
+ * Both are fixed point: samples carry 7 fraction bits, coefficients 14,
+ * which keeps every product within 32 bits.
+ *
+ * Define FILTER_SIMD to filter the left and right channels together with
+ * GCC vector extensions (SSE2/NEON on a PC). The result is the same.
+ */
+
+#pragma once
+
+#define FILTER_FRAC     7
+#define FILTER_SHIFT    14
+#define FILTER_ONE      (1 << FILTER_SHIFT)
+
+struct filter_s
+{
+    int32_t hpf;        /* High-pass pole, 0 = off */
+    int32_t lpf;        /* Low-pass gain, 0 = off */
+
+    /* Per channel, left then right */
+    int32_t in[2];      /* Last input */
+    int32_t hp[2];      /* Last high-pass output */
+    int32_t lp[2];      /* Last low-pass output */
+};
+
+
+/**
+ * Clears the filter history, for the start of a song.
+ */
+void filter_reset(struct filter_s *f){
+    for(int c = 0; c < 2; c++){
+        f->in[c] = 0;
+        f->hp[c] = 0;
+        f->lp[c] = 0;
+    }
+}
+
+/**
+ * Sets the cutoff frequencies in Hz, 0 turns that filter off. The
+ * coefficients are those of an RC filter, with w = 2 pi fc / fs:
+ * hpf = 1 / (1 + w), lpf = w / (1 + w).
+ */
+void filter_init(struct filter_s *f, uint32_t hpfHz, uint32_t lpfHz){
+    uint32_t w;
+
+    w = (uint64_t)hpfHz * 710 * FILTER_ONE / (113 * SAMPLE_RATE);  // 2 pi ~ 710 / 113
+    f->hpf = hpfHz ? (uint32_t)FILTER_ONE * FILTER_ONE / (FILTER_ONE + w) : 0;
+    w = (uint64_t)lpfHz * 710 * FILTER_ONE / (113 * SAMPLE_RATE);
+    f->lpf = lpfHz ? (uint32_t)FILTER_ONE * w / (FILTER_ONE + w) : 0;
+    filter_reset(f);
+}
+
+
+static inline int8_t filter_clamp(int32_t x){
+    x = (x + (1 << (FILTER_FRAC - 1))) >> FILTER_FRAC;
+    return x > 127 ? 127 : (x < -128 ? -128 : x);
+}
+
+#ifdef FILTER_SIMD
+typedef int32_t filter_v2 __attribute__((vector_size(8)));
+
+/**
+ * Filters frames of interleaved stereo samples in place.
+ */
+void filter_block(struct filter_s *f, int8_t *buf, uint32_t frames){
+    filter_v2 in = {f->in[0], f->in[1]};
+    filter_v2 hp = {f->hp[0], f->hp[1]};
+    filter_v2 lp = {f->lp[0], f->lp[1]};
+    filter_v2 x, y;
+
+    for(uint32_t i = 0; i < frames; i++){
+        x = (filter_v2){buf[0], buf[1]} << FILTER_FRAC;
+        y = x;
+        if(f->hpf){
+            hp = x - in + ((hp * f->hpf + FILTER_ONE / 2) >> FILTER_SHIFT);
+            in = x;
+            y = hp;
+        }
+        if(f->lpf){
+            lp += ((y - lp) * f->lpf + FILTER_ONE / 2) >> FILTER_SHIFT;
+            y = lp;
+        }
+        buf[0] = filter_clamp(y[0]);
+        buf[1] = filter_clamp(y[1]);
+        buf += 2;
+    }
+
+    f->in[0] = in[0]; f->in[1] = in[1];
+    f->hp[0] = hp[0]; f->hp[1] = hp[1];
+    f->lp[0] = lp[0]; f->lp[1] = lp[1];
+}
+#else
+/**
+ * Filters frames of interleaved stereo samples in place.
+ */
+void filter_block(struct filter_s *f, int8_t *buf, uint32_t frames){
+    for(int c = 0; c < 2; c++){
+        int32_t in = f->in[c], hp = f->hp[c], lp = f->lp[c];
+        int32_t x, y;
+
+        for(uint32_t i = 0; i < frames; i++){
+            x = buf[i * 2 + c] << FILTER_FRAC;
+            y = x;
+            if(f->hpf){
+                hp = x - in + ((hp * f->hpf + FILTER_ONE / 2) >> FILTER_SHIFT);
+                in = x;
+                y = hp;
+            }
+            if(f->lpf){
+                lp += ((y - lp) * f->lpf + FILTER_ONE / 2) >> FILTER_SHIFT;
+                y = lp;
+            }
+            buf[i * 2 + c] = filter_clamp(y);
+        }
+
+        f->in[c] = in;
+        f->hp[c] = hp;
+        f->lp[c] = lp;
+    }
+}
+#endif
@@ -0,0 +1,427 @@
+/*
+ * Ahead of time compiler. Turns the code of one GBS file into C, a function
+ * per block, for the CPU core to run instead of translating those blocks:
+ * build with GB_AOT defined as the name of the header written. The
+ * compiled code only runs if the GBS loaded is the same file (same size and
+ * hash); anything else, and code that was not found here, runs as before.
+ *
+ * Usage: gbs_aot [-l seconds] [-n blocks] [-o gbs_aot.h] file.gbs
+ *
+ * Blocks are found by following the branches from the init and play
+ * routines, and by playing every song for seconds (30 by default) and
+ * noting where jumps land, which finds code reached through JP HL, RET and
+ * bank switches that the static pass cannot follow. At most blocks (4096 by
+ * default) are written.
+ *
+ * Each instruction is a call to a function for its opcode, written once per
+ * opcode used, that runs __gb_execute with the opcode as a constant: the
+ * compiler folds that down to the code of the one case, small enough to be
+ * inlined into every block, so the compiled blocks behave exactly like the
+ * interpreter. It takes an optimised build to fold them; unoptimised, each
+ * of them is the whole interpreter. A function stops after at most
+ * MAX_INSTRUCTIONS, and the interpreter runs the rest. A block can be
+ * entered at any of its instructions, as runs end wherever the timers and
+ * LCD need ticking. One that ends in a branch goes straight on into the
+ * block it lands in, while that is known to be compiled and in the same ROM
+ * bank.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define SAMPLE_RATE 44100
+#define MIX_BLOCK 64
+#define REG_QUEUE_IDLE() do{}while(0)
+
+#define STATS_NOW() 0
+#define STATS_TICK_MASK 0xFFFFFFFF
+#define STATS_TICK_HZ 1000000000
+
+#include "tables.h"
+#include "stats.h"
+#include "reg_queue.h"
+#include "clock.h"
+#include "mix.h"
+#include "apu.h"
+#include "peanut_gb.h"
+#include "read_file.h"
+
+#define DEFAULT_SECONDS 30
+#define DEFAULT_BLOCKS 4096
+#define MAX_INSTRUCTIONS 64  // In one function, so that code run on into empty ROM is not all written out
+
+// Tags are 23 bits: the address, with the ROM bank (at most 0x7F) above it
+#define TAG_BITS 23
+
+struct insn_s
+{
+	uint8_t opcode;
+	uint8_t length;
+	uint16_t imm;
+};
+
+static struct gb_s gb;
+static struct reg_queue_s queue;
+static struct stats_s stats;
+static uint8_t starts[1 << (TAG_BITS - 3)];  // Bit per tag: a block starts there
+static uint8_t compiled[1 << (TAG_BITS - 3)];  // Bit per tag: a function is written for it
+static uint32_t *work;  // Tags still to follow, with the bank in use above them
+static uint32_t workCount, workSize;
+static uint8_t entered[1 << (TAG_BITS - 3)];  // Bit per tag: an instruction in one of the functions
+static uint32_t (*entries)[2];  // Each instruction in a function, and the tag of the function
+static uint32_t entryCount, entrySize;
+static uint8_t opcodes[0x100 >> 3];  // Bit per opcode: it is in one of the functions
+
+
+static bool bit_get(const uint8_t *bits, uint32_t tag){
+	return bits[tag >> 3] & (1 << (tag & 7));
+}
+
+static void bit_set(uint8_t *bits, uint32_t tag){
+	bits[tag >> 3] |= 1 << (tag & 7);
+}
+
+
+static uint32_t tag_of(uint16_t pc, uint8_t bank){
+	return pc >= ROM_N_ADDR ? pc | (bank << 16) : pc;
+}
+
+
+// Notes that a block starts at pc, in the ROM bank given, and queues it to be followed
+static void add_start(uint16_t pc, uint8_t bank){
+	uint32_t tag = tag_of(pc, bank);
+
+	if(pc < 0x0010 || pc >= VRAM_ADDR || bit_get(starts, tag)) return;
+	bit_set(starts, tag);
+	if(workCount == workSize){
+		workSize = workSize ? workSize * 2 : 1024;
+		work = realloc(work, workSize * sizeof(uint32_t));
+	}
+	work[workCount++] = tag | (bank << 24);
+}
+
+
+// Reads the instruction at tag, false if there is none the block engine would run there
+static bool decode(uint32_t tag, struct insn_s *in){
+	uint16_t pc = tag;
+	uint32_t left = ROM_BANK_SIZE - (pc & (ROM_BANK_SIZE - 1));
+
+	gb.selected_rom_bank = tag >> 16 ? tag >> 16 : 1;
+	in->opcode = __gb_read(&gb, pc);
+	switch(in->opcode){
+	case 0xD3: case 0xDB: case 0xDD: case 0xE3: case 0xE4: case 0xEB:
+	case 0xEC: case 0xED: case 0xF4: case 0xFC: case 0xFD:
+		return false;
+	}
+	in->length = GB_OP_LENGTH[in->opcode];
+	if(in->length > left) return false;
+	in->imm = in->length > 1 ? __gb_read(&gb, pc + 1) : 0;
+	if(in->length > 2) in->imm |= __gb_read(&gb, pc + 2) << 8;
+	return true;
+}
+
+
+// Where a branch, call or RST goes if taken; false for the ones whose target is not in the code
+static bool branch_target(const struct insn_s *in, uint16_t next, uint16_t *target){
+	switch(in->opcode){
+	case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+		*target = next + (int8_t)in->imm;
+		return true;
+	case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA:
+	case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:
+		*target = in->imm;
+		return true;
+	case 0xC7: case 0xCF: case 0xD7: case 0xDF:
+	case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+		*target = (in->opcode - 0xC7) + gb.load_address;
+		return true;
+	}
+	return false;
+}
+
+// True if the instruction after this one runs next, now or once a call returns
+static bool falls_through(uint8_t opcode){
+	switch(opcode){
+	case 0x18: case 0xC3: case 0xE9: case 0xC9: case 0xD9:
+		return false;
+	}
+	return true;
+}
+
+
+// Follows the code from one block start, noting the starts it leads to
+static void follow(uint32_t item){
+	uint16_t pc = item;
+	uint8_t bank = item >> 24;
+	int loadA = -1;  // The value of A, if the last instruction was LD A, n
+	struct insn_s in;
+	uint16_t target;
+
+	for(uint32_t count = 0; count < MAX_INSTRUCTIONS && decode(tag_of(pc, bank), &in); count++){
+		uint16_t next = pc + in.length;
+
+		if(branch_target(&in, next, &target)) add_start(target, bank);
+		if(__gb_ends_block(in.opcode)){
+			if(falls_through(in.opcode)) add_start(next, bank);
+			return;
+		}
+
+		// LD A, n then LD (2000-3FFF), A: the usual ROM bank switch
+		if(in.opcode == 0xEA && in.imm >= 0x2000 && in.imm < 0x4000 && loadA >= 0){
+			bank = (loadA & 0x1F) | (bank & 0x60);
+			if(!(bank & 0x1F)) bank++;
+			add_start(next, bank);
+			return;
+		}
+		loadA = in.opcode == 0x3E ? in.imm : -1;
+		pc = next;
+
+		// Blocks end where the next 16 KB starts, as the engine's do
+		if(!(pc & (ROM_BANK_SIZE - 1))){
+			add_start(pc, bank);
+			return;
+		}
+	}
+}
+
+
+// Plays every song for a while, noting the starts the CPU jumps to
+static void trace_songs(uint32_t seconds){
+	for(uint8_t song = 0; song < gb.song_count; song++){
+		gb_init(&gb, song);
+		for(uint32_t frame = 0; frame < seconds * 60; frame++){
+			gb.frame_cycles += clock_step(&gb.frame_clock, 1);
+			while(gb.frame_cycles > 0){
+				// Halted up to the next interrupt, the block engine skips straight to it
+				if(gb.gb_halt && !gb.intr_pending){
+					__gb_run_block(&gb);
+					continue;
+				}
+
+				uint16_t pc = gb.cpu_reg.pc;
+				uint8_t length = !gb.gb_halt && pc < VRAM_ADDR ? GB_OP_LENGTH[__gb_read(&gb, pc)] : 0;
+
+				__gb_step_cpu(&gb);
+				while(reg_queue_event_ready(&queue)) reg_queue_pop(&queue);
+				if(gb.cpu_reg.pc != (uint16_t)(pc + length)) add_start(gb.cpu_reg.pc, gb.selected_rom_bank);
+			}
+		}
+	}
+}
+
+
+// True if the engine finds an idle loop at tag, which __gb_run_block has to see go round to skip it
+static bool idle_loop(uint32_t tag){
+	static struct gb_block_s b;
+
+	gb.selected_rom_bank = tag >> 16 ? tag >> 16 : 1;
+	__gb_translate(&gb, &b, tag, tag);
+	return b.idle;
+}
+
+// True if a block that started at tag can go straight on into the one at pc
+static bool can_chain(uint32_t tag, uint16_t pc){
+	// From bank 0 it is not known which bank the code at 0x4000-0x7FFF is in
+	if(pc < 0x0010 || pc >= VRAM_ADDR || (pc >= ROM_N_ADDR && !(tag >> 16))) return false;
+	return bit_get(compiled, tag_of(pc, tag >> 16)) && !idle_loop(tag_of(pc, tag >> 16));
+}
+
+static bool conditional(uint8_t opcode){
+	switch(opcode){
+	case 0x20: case 0x28: case 0x30: case 0x38:
+	case 0xC2: case 0xCA: case 0xD2: case 0xDA:
+	case 0xC4: case 0xCC: case 0xD4: case 0xDC:
+	case 0xC0: case 0xC8: case 0xD0: case 0xD8:
+		return true;
+	}
+	return false;
+}
+
+// Writes the end of a block that started at tag: go on at pc if PC is there, or if always is set
+static void write_chain(FILE *out, uint32_t tag, uint16_t pc, bool always){
+	if(!can_chain(tag, pc)){
+		if(always) fprintf(out, "\treturn false;\n");
+	}else if(always){
+		fprintf(out, "\treturn gb_aot_%06X(gb, instructions);\n", tag_of(pc, tag >> 16));
+	}else{
+		fprintf(out, "\tif(gb->cpu_reg.pc == 0x%04X) return gb_aot_%06X(gb, instructions);\n", pc, tag_of(pc, tag >> 16));
+	}
+}
+
+// Notes that the function for the block at tag can be entered at the instruction at entry, unless another one already is
+static void add_entry(uint32_t entry, uint32_t tag){
+	if(bit_get(entered, entry)) return;
+	bit_set(entered, entry);
+	if(entryCount == entrySize){
+		entrySize = entrySize ? entrySize * 2 : 1024;
+		entries = realloc(entries, entrySize * sizeof(entries[0]));
+	}
+	entries[entryCount][0] = entry;
+	entries[entryCount++][1] = tag;
+}
+
+static int compare_entries(const void *a, const void *b){
+	uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+	return x < y ? -1 : x > y;
+}
+
+// Writes the function for the block at tag, which runs from any instruction in it, returning the number of instructions in it
+static uint32_t write_block(FILE *out, uint32_t tag){
+	uint16_t pc = tag;
+	uint32_t count = 0;
+	struct insn_s in;
+	uint16_t target;
+
+	fprintf(out, "static bool gb_aot_%06X(struct gb_s *gb, uint32_t *instructions){\n", tag);
+	fprintf(out, "\tstruct cpu_registers_s cpu = gb->cpu_reg;\n\n");
+	fprintf(out, "\tswitch(cpu.pc){\n");
+	for(;;){
+		if(!decode(tag_of(pc, tag >> 16), &in)){
+			fprintf(out, "\t}\n\tgb->cpu_reg = cpu;\n\treturn false;\n");
+			break;
+		}
+
+		uint16_t next = pc + in.length;
+		// Each instruction runs on into the next, from wherever the block is entered
+		if(count) fprintf(out, "\t__attribute__((fallthrough));\n");
+		fprintf(out, "\tcase 0x%04X: GB_AOT_OP(0x%04X, %02X, 0x%04X);\n", pc, next, in.opcode, in.imm);
+		add_entry(tag_of(pc, tag >> 16), tag);
+		bit_set(opcodes, in.opcode);
+		count++;
+
+		if(__gb_ends_block(in.opcode)){
+			fprintf(out, "\t}\n\tgb->cpu_reg = cpu;\n");
+			// Where a conditional one went is told from PC
+			if(branch_target(&in, next, &target)){
+				if(conditional(in.opcode) && target != next){
+					if(can_chain(tag, target)) write_chain(out, tag, target, false);
+					else if(can_chain(tag, next)) fprintf(out, "\tif(gb->cpu_reg.pc == 0x%04X) return false;\n", target);
+					write_chain(out, tag, next, true);
+				}else{
+					write_chain(out, tag, target, true);
+				}
+			}else if(conditional(in.opcode)){
+				write_chain(out, tag, next, false);
+				fprintf(out, "\treturn false;\n");
+			}else{
+				// RET, RETI and JP HL go where the stack or HL says, HALT and EI need the checks between blocks
+				fprintf(out, "\treturn false;\n");
+			}
+			break;
+		}
+
+		pc = next;
+		if(bit_get(starts, tag_of(pc, tag >> 16)) || !(pc & (ROM_BANK_SIZE - 1)) || count == MAX_INSTRUCTIONS){
+			fprintf(out, "\t}\n\tgb->cpu_reg = cpu;\n");
+			write_chain(out, tag, pc, true);
+			break;
+		}
+	}
+	fprintf(out, "}\n\n");
+	return count;
+}
+
+
+int main(int argc, char **argv){
+	const char *inName = NULL, *outName = NULL;
+	uint32_t seconds = DEFAULT_SECONDS, maxBlocks = DEFAULT_BLOCKS;
+	uint32_t blocks = 0, instructions = 0;
+
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-l") && i + 1 < argc) seconds = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-n") && i + 1 < argc) maxBlocks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-o") && i + 1 < argc) outName = argv[++i];
+		else inName = argv[i];
+	}
+	if(!inName){
+		fprintf(stderr, "Usage: %s [-l seconds] [-n blocks] [-o gbs_aot.h] file.gbs\n", argv[0]);
+		return 1;
+	}
+
+	uint32_t size = 0;
+	uint8_t *data = read_file(inName, &size);
+	if(!data) return 1;
+	if(!gb_load_gbs(&gb, data, size)){
+		fprintf(stderr, "%s: not a GBS file\n", inName);
+		return 1;
+	}
+	reg_queue_init(&queue);
+	gb.apu_queue = &queue;
+	gb.stats = &stats;
+
+	add_start(gb.init_address, 1);
+	add_start(gb.play_address, 1);
+	trace_songs(seconds);
+	while(workCount) follow(work[--workCount]);
+
+	// Lowest addresses first, so bank 0 is always in if there are too many
+	for(uint32_t tag = 0; tag < 1u << TAG_BITS; tag++){
+		struct insn_s in;
+
+		if(!bit_get(starts, tag) || !decode(tag, &in)) continue;
+		if(blocks == maxBlocks){
+			fprintf(stderr, "%s: more than %u blocks, the rest are left to the interpreter\n", inName, maxBlocks);
+			break;
+		}
+		bit_set(compiled, tag);
+		blocks++;
+	}
+
+	// The functions first, to know which opcodes they use
+	FILE *body = tmpfile();
+	if(!body){
+		perror("tmpfile");
+		return 1;
+	}
+	for(uint32_t tag = 0; tag < 1u << TAG_BITS; tag++){
+		if(bit_get(compiled, tag)) instructions += write_block(body, tag);
+	}
+
+	FILE *out = outName ? fopen(outName, "w") : stdout;
+	if(!out){
+		perror(outName);
+		return 1;
+	}
+	fprintf(out, "/* Compiled by gbs_aot from %s, do not edit. */\n\n", inName);
+	fprintf(out, "#define GB_AOT_SIZE %u\n", size);
+	fprintf(out, "#define GB_AOT_HASH 0x%08X\n\n", gb_gbs_hash(data, size));
+	fprintf(out, "#ifdef __OPTIMIZE__\n"
+		"#define GB_AOT_EXECUTE(opcode, imm) __gb_execute(gb, cpu, opcode, imm)\n"
+		"#else\n"
+		"/* Nothing folds __gb_execute unoptimised: the opcodes share one copy. */\n"
+		"static uint8_t gb_aot_execute(struct gb_s *gb, struct cpu_registers_s *cpu, uint8_t opcode, uint16_t imm){\n"
+		"\treturn __gb_execute(gb, cpu, opcode, imm);\n"
+		"}\n"
+		"#define GB_AOT_EXECUTE(opcode, imm) gb_aot_execute(gb, cpu, opcode, imm)\n"
+		"#endif\n\n");
+	for(int op = 0; op < 0x100; op++){
+		if(bit_get(opcodes, op)) fprintf(out, "static inline uint8_t gb_aot_op_%02X(struct gb_s *gb, struct cpu_registers_s *cpu, uint16_t imm){\n"
+			"\treturn GB_AOT_EXECUTE(0x%02X, imm);\n}\n\n", op, op);
+	}
+	fprintf(out, "#define GB_AOT_OP(next, opcode, imm) do{ \\\n"
+		"\tcpu.pc = next; \\\n"
+		"\t++*instructions; \\\n"
+		"\tif(__gb_block_end(gb, gb_aot_op_##opcode(gb, &cpu, imm))){ \\\n"
+		"\t\tgb->cpu_reg = cpu; \\\n"
+		"\t\treturn true; \\\n"
+		"\t} \\\n"
+		"}while(0)\n\n");
+	for(uint32_t tag = 0; tag < 1u << TAG_BITS; tag++){
+		if(bit_get(compiled, tag)) fprintf(out, "static bool gb_aot_%06X(struct gb_s *gb, uint32_t *instructions);\n", tag);
+	}
+	fprintf(out, "\n");
+	rewind(body);
+	for(int c; (c = fgetc(body)) != EOF;) fputc(c, out);
+	fclose(body);
+	fprintf(out, "#undef GB_AOT_OP\n#undef GB_AOT_EXECUTE\n\n");
+	fprintf(out, "static gb_aot_block_t gb_aot_find(uint32_t tag){\n\tswitch(tag){\n");
+	qsort(entries, entryCount, sizeof(entries[0]), compare_entries);
+	for(uint32_t i = 0; i < entryCount; i++) fprintf(out, "\tcase 0x%06X: return gb_aot_%06X;\n", entries[i][0], entries[i][1]);
+	fprintf(out, "\t}\n\treturn NULL;\n}\n");
+	if(out != stdout) fclose(out);
+
+	fprintf(stderr, "%s: %u blocks, %u instructions\n", inName, blocks, instructions);
+	return 0;
+}
@@ -3,73 +3,168 @@
 #include "hardware/irq.h"  // interrupts
 #include "hardware/pwm.h"  // pwm 
 #include "hardware/sync.h" // wait for interrupt 
+#include "pico/multicore.h" // emulation runs on core 1
+#include "hardware/structs/systick.h" // cycle counter for stats
  
 // Audio PIN is to match some of the design guide shields. 
 #define AUDIO_PIN_L 28  // you can change this to whatever you like
 #define AUDIO_PIN_R 27  // you can change this to whatever you like
 
-#define SAMPLE_RATE 44100
+#define SAMPLE_RATE 44100  // Synthesis rate
+#define OUTPUT_RATE 44100  // PWM rate, the mix is resampled to it if it differs (8000 - 96000)
+#define SYS_CLOCK_KHZ 132000
+#define PWM_WRAP 250
 #define BUFFER_SIZE 0x1000  // (Needs to be a multiple of 2)
 #define BUFFER_SIZE_HALF (BUFFER_SIZE >> 1)
 #define DEFAULT_LENGTH 90  // Default song length in seconds
 #define MUTE_THRESHOLD (SAMPLE_RATE * 4)  // How long a song should stay silent before ending
+#define STATS_INTERVAL 10  // Seconds between stats printed over UART, 0 to disable
+#define MIX_BLOCK 64  // Stereo samples mixed and filtered at a time
+#define FILTER_HPF_HZ 28  // DC blocking high-pass, about what the DMG's output capacitor does. 0 to disable
+#define FILTER_LPF_HZ 14000  // Output low-pass, 0 to disable
+#define CHANNEL_MASK 0x0F  // Channels to play, bit 0 is channel 1 (apu_set_channel_mask() changes it at runtime)
+#define INSTANCES 1  // GBS engines mixed together, engine n plays song + n. Engine 0 decides when a song ends
+#define INSTANCE_VOLUME 256  // Volume of each engine, 256 = full, at most 512 (apu_set_volume() changes it at runtime)
+#define FADE_SECONDS 16  // Length of the fade out at the end of a song
+#define FADE_CURVE FADE_LINEAR  // FADE_LINEAR, FADE_EQUAL_POWER or FADE_EXPONENTIAL
+#define BENCHMARK_SECONDS 0  // Seconds of the first song to time at startup, to see how many engines fit. 0 to disable
 
-float soundChannelPos[4];
-int16_t soundChannel4Bit;
-const int16_t *PU1Table;
-const int16_t *PU2Table;
-const uint8_t *PU4Table;
-uint16_t PU4TableLen;
-uint32_t gbFrame, apuFrame;
-uint8_t apuCycle;
+struct clock_s frameClock;  // Samples to frames
 int8_t output[BUFFER_SIZE];
 uint16_t readPos, fillPos;
 uint8_t song, maxSongs;
 
-float fadeout;
 uint16_t songTime, secFrame;
 uint32_t mutedTime;
 
 #include "tables.h"
-#include "lfsr.h"
+#include "stats.h"
+#include "reg_queue.h"
+#include "clock.h"
+#include "mix.h"
+#include "apu.h"
+#include "filter.h"
+#include "resample.h"
+#include "fade.h"
 #include "peanut_gb.h"
+#include "engine.h"
 
 #include "gbs.h"
 
-static struct gb_s gb;
+static struct engine_s engines[2][INSTANCES];  // The song playing, and the next one pre-rolling
+static struct engine_s *playing = engines[0], *spare = engines[1];
+static bool prerolling;
+static struct fade_s fade;
+static struct stats_s stats;
+static struct stats_s report;  // Taken at the end of each STATS_INTERVAL
+static bool reportDue;
+static struct filter_s filter;
+static struct resample_s resampler;
+static int8_t block[MIX_BLOCK * 2];
+static int8_t resampled[RESAMPLE_MAX_OUT * 2];
 
 
 void pwm_interrupt_handler() {
     pwm_clear_irq(pwm_gpio_to_slice_num(AUDIO_PIN_L));
     pwm_clear_irq(pwm_gpio_to_slice_num(AUDIO_PIN_R));
-	if(fadeout == 1.0f){
-		pwm_set_gpio_level(AUDIO_PIN_L, output[readPos++] + 0x80);
-		pwm_set_gpio_level(AUDIO_PIN_R, output[readPos++] + 0x80);
-	}else{
-		pwm_set_gpio_level(AUDIO_PIN_L, (output[readPos++] * fadeout) + 0x80);
-		pwm_set_gpio_level(AUDIO_PIN_R, (output[readPos++] * fadeout) + 0x80);
-	}
+	if(readPos == fillPos) stats.underruns++;
+	pwm_set_gpio_level(AUDIO_PIN_L, output[readPos++] + 0x80);
+	pwm_set_gpio_level(AUDIO_PIN_R, output[readPos++] + 0x80);
 	if(readPos >= BUFFER_SIZE) readPos -= BUFFER_SIZE;
 }
 
 
+// Mixes samples from to to-1 of the block, and watches for the song having gone silent
+void mix_samples(uint32_t from, uint32_t to){
+	engine_mix(playing, INSTANCES, from, to, &fade, &block[from * 2]);
+	for(uint32_t i = from; i < to; i++){
+		if((block[i * 2] | block[i * 2 + 1]) == 0){
+			if(++mutedTime >= MUTE_THRESHOLD) fade_start(&fade, 0, 0, FADE_LINEAR);  // Silencing the fade will trigger the next song on the next gbframe
+		}else{
+			mutedTime = 0;
+		}
+	}
+	if(playing[0].apu.idleTimer >= MUTE_THRESHOLD) fade_start(&fade, 0, 0, FADE_LINEAR);
+}
+
+
+// Times one engine on this core, both sides of the queue, before anything else starts
+void benchmark(void){
+	uint32_t producer, consumer;
+
+	engine_benchmark(&playing[0], song, BENCHMARK_SECONDS, &producer, &consumer);
+	printf("benchmark: producer %lu us/s, mixer %lu us/s per engine, %lu engines fit\n",
+		(unsigned long)(producer / (STATS_TICK_HZ / 1000000)), (unsigned long)(consumer / (STATS_TICK_HZ / 1000000)),
+		(unsigned long)(STATS_TICK_HZ / (producer > consumer ? producer : consumer)));
+	stats_reset(&stats);
+}
+
+
+// Changes the output rate: the PWM interrupt rate and the resampler
+void set_output_rate(uint32_t rate){
+	rate = resample_init(&resampler, rate);
+	pwm_set_clkdiv(pwm_gpio_to_slice_num(AUDIO_PIN_L), (SYS_CLOCK_KHZ * 1000.0f) / (PWM_WRAP * rate));
+	pwm_set_clkdiv(pwm_gpio_to_slice_num(AUDIO_PIN_R), (SYS_CLOCK_KHZ * 1000.0f) / (PWM_WRAP * rate));
+}
+
+
+// Core 1: CPU emulation, feeds the register queue
+void core1_entry(void){
+	stats_start();
+	while(1){
+		if(!(engine_produce(engines[0], INSTANCES) | engine_produce(engines[1], INSTANCES))) tight_loop_contents();
+	}
+}
+
+
+// Core 0: everything below runs on the mixing side of the queue
+
+// Starts a song from silence
 void play_song(uint8_t song){
-	gb_init(&gb, song);
-	fadeout = 1.0f;
+	for(uint32_t i = 0; i < INSTANCES; i++){
+		apu_request_song(&playing[i].apu, &playing[i].queue, (song + i) % maxSongs);
+	}
+	filter_reset(&filter);
+	resample_reset(&resampler);
+	fade_init(&fade);
 	songTime = 0;
 	secFrame = 0;
 	mutedTime = 0;
 	readPos = 0;
 	fillPos = 0;
 	for(uint32_t i = 0; i < BUFFER_SIZE; i++) output[i] = 0;
-	soundChannelPos [0] = 0;
-	soundChannelPos [1] = 0.01;
-	soundChannelPos [2] = 0;
-	soundChannelPos [3] = 0;
-
-	gbFrame = SAMPLE_RATE;
-	apuFrame = SAMPLE_RATE;
-	apuCycle = 0;
+
+	clock_init_due(&frameClock, SAMPLE_RATE, CLOCK_FRAME_HZ);
+}
+
+
+// Starts the next song on the spare engines while this one fades out, so its init routine
+// and first frames are emulated by the time it is needed
+void preroll_song(uint8_t song){
+	for(uint32_t i = 0; i < INSTANCES; i++){
+		apu_request_song(&spare[i].apu, &spare[i].queue, (song + i) % maxSongs);
+	}
+	prerolling = true;
+}
+
+
+// Switches to the pre-rolled song from this sample on. The output buffer, filter and resampler
+// carry straight on, so there is no gap. Until the spare engines have started the next song
+// (straight after a fade for silence, it has not been asked for yet) the faded one plays on,
+// silent, as the spare ones would still sound like whatever they played last
+void splice_song(void){
+	struct engine_s *faded = playing;
+
+	if(!prerolling) preroll_song(song + 1 < maxSongs ? song + 1 : 0);
+	if(!engine_preroll(spare, INSTANCES)) return;
+	if(++song >= maxSongs) song -= maxSongs;
+	playing = spare;
+	spare = faded;
+	prerolling = false;
+	fade_init(&fade);
+	songTime = 0;
+	secFrame = 0;
+	mutedTime = 0;
 }
 
 
@@ -78,21 +173,22 @@ int main(void) {
      * multiple of typical audio sampling rates.
      */
     stdio_init_all();
-    set_sys_clock_khz(132000, true); 
+    set_sys_clock_khz(SYS_CLOCK_KHZ, true); 
     gpio_set_function(AUDIO_PIN_L, GPIO_FUNC_PWM);
     gpio_set_function(AUDIO_PIN_R, GPIO_FUNC_PWM);
 
-	for(int i = 0; i < 0x70; i++) gb.rom[i] = gbs[i];
-	maxSongs = gb.rom[0x04];
-	song = gb.rom[0x05] - 1;
-	gb.load_address = gb.rom[0x06] + (gb.rom[0x07] << 8);
-	gb.init_address = gb.rom[0x08] + (gb.rom[0x09] << 8);
-	gb.play_address = gb.rom[0x0A] + (gb.rom[0x0B] << 8);
-	gb.stack_pointer = gb.rom[0x0C] + (gb.rom[0x0D] << 8);
-	gb.timer_modulo = gb.rom[0x0E];
-	gb.timer_control = gb.rom[0x0F];
-	for(int i = 0; i < gb.load_address; i++) gb.rom[i] = 0x00;
-	for(int i = 0; i < 0x19E81; i++) gb.rom[i + gb.load_address] = gbs[i + 0x70];
+	stats_reset(&stats);
+	stats_start();
+	for(uint32_t i = 0; i < INSTANCES * 2; i++){
+		struct engine_s *e = &engines[i / INSTANCES][i % INSTANCES];
+		maxSongs = engine_load(e, gbs, sizeof(gbs), &stats);
+		apu_set_channel_mask(&e->apu, CHANNEL_MASK);
+		apu_set_volume(&e->apu, INSTANCE_VOLUME);
+	}
+	song = playing[0].gb.first_song;
+	if(BENCHMARK_SECONDS) benchmark();
+	filter_init(&filter, FILTER_HPF_HZ, FILTER_LPF_HZ);
+	multicore_launch_core1(core1_entry);
 
 
     int audio_pin_slice_l = pwm_gpio_to_slice_num(AUDIO_PIN_L);
@@ -119,205 +215,67 @@ int main(void) {
      *  4.0f for 22 KHz
      *  2.0f for 44 KHz etc
      */
-    pwm_config_set_clkdiv( & config, 12.0f); 
-    pwm_config_set_wrap( & config, 250); 
+    pwm_config_set_clkdiv( & config, (SYS_CLOCK_KHZ * 1000.0f) / (PWM_WRAP * OUTPUT_RATE)); 
+    pwm_config_set_wrap( & config, PWM_WRAP); 
     pwm_init(audio_pin_slice_l, & config, true);
     pwm_init(audio_pin_slice_r, & config, true);
 
     pwm_set_gpio_level(AUDIO_PIN_L, 0);
     pwm_set_gpio_level(AUDIO_PIN_R, 0);
 
+	set_output_rate(OUTPUT_RATE);
 	play_song(song);
 
     while(1) {
-		if((fillPos >= readPos && fillPos - readPos < BUFFER_SIZE_HALF) || (fillPos < readPos && (fillPos + BUFFER_SIZE) - readPos < BUFFER_SIZE_HALF)){
-			secFrame++;
-			if(secFrame >= SAMPLE_RATE){
-				secFrame -= SAMPLE_RATE;
-				if(++songTime == DEFAULT_LENGTH){
-					fadeout = 0.999f;
-				}
-			}
-
-			gbFrame += 60;
-			if(gbFrame >= SAMPLE_RATE){
-				gbFrame -= SAMPLE_RATE;
-				if(fadeout < 1.0f){
-					fadeout -= 0.001f;
-					if(fadeout <= 0){
-						if(++song >= maxSongs) song -= maxSongs;
-						play_song(song);
-					}
-				}
-				gb.gb_frame = 0;
-				while(!gb.gb_frame) __gb_step_cpu(&gb);
-				
-				switch(gb.hram[0x11] & 0xC0){
-					case 0x00:
-						PU1Table = PU0;
-					break;
-					case 0x40:
-						PU1Table = PU1;
-					break;
-					case 0x80:
-						PU1Table = PU2;
-					break;
-					case 0xC0:
-						PU1Table = PU3;
-					break;
-				}
-
-				switch(gb.hram[0x16] & 0xC0){
-					case 0x00:
-						PU2Table = PU0;
-					break;
-					case 0x40:
-						PU2Table = PU1;
-					break;
-					case 0x80:
-						PU2Table = PU2;
-					break;
-					case 0xC0:
-						PU2Table = PU3;
-					break;
-				}
-
-				switch(gb.hram[0x22] & 0x08){
-					case 0x00:
-						PU4Table = lfsr15;
-						PU4TableLen = 0x7FFF;
-					break;
-					case 0x08:
-						PU4Table = lfsr7;
-						PU4TableLen = 0x7F;
-					break;
-				}
-			}
+		uint16_t fill = (fillPos >= readPos) ? fillPos - readPos : (fillPos + BUFFER_SIZE) - readPos;
+		if(fill < stats.bufferMin) stats.bufferMin = fill;
+		if(fill < BUFFER_SIZE_HALF){
+			uint32_t start = STATS_NOW();
+			uint32_t i, n, mixed = 0;
 
-			apuFrame += 512;
-			if(apuFrame >= SAMPLE_RATE){
-				apuFrame -= SAMPLE_RATE;
-				apuCycle++;
-
-				if((apuCycle & 1) == 0){  // Length
-					if(gb.audio.ch1Len){
-						if(--gb.audio.ch1Len == 0 && gb.audio.ch1LenOn){
-							gb.hram[0x26] &= 0xFE;
-						}
-					}
-					
-					if(gb.audio.ch2Len){
-						if(--gb.audio.ch2Len == 0 && gb.audio.ch2LenOn){
-							gb.hram[0x26] &= 0xFD;
-						}
-					}
-					
-					if(gb.audio.ch3Len){
-						if(--gb.audio.ch3Len == 0 && gb.audio.ch3LenOn){
-							gb.hram[0x26] &= 0xFB;
-						}
+			for(i = 0; i < MIX_BLOCK; i++){
+				secFrame++;
+				if(secFrame >= SAMPLE_RATE){
+					secFrame -= SAMPLE_RATE;
+					if(++songTime == DEFAULT_LENGTH){
+						fade_start(&fade, 0, FADE_SECONDS * SAMPLE_RATE, FADE_CURVE);
+						preroll_song(song + 1 < maxSongs ? song + 1 : 0);
 					}
-					
-					if(gb.audio.ch4Len){
-						if(--gb.audio.ch4Len == 0 && gb.audio.ch4LenOn){
-							gb.hram[0x26] &= 0xF7;
-						}
+					if(STATS_INTERVAL && songTime % STATS_INTERVAL == 0){
+						report = stats;  // Printed once the buffer is full enough, outside the time taken
+						reportDue = true;
+						stats_reset(&stats);
 					}
 				}
 
-				if((apuCycle & 7) == 7){  // Envelope
-					if(gb.audio.ch1EnvCounter){
-						if(--gb.audio.ch1EnvCounter == 0){
-							if(gb.audio.ch1Vol && !gb.audio.ch1EnvDir){
-								gb.audio.ch1Vol--;
-								gb.audio.ch1EnvCounter = gb.audio.ch1EnvCounterI;
-							}else if(gb.audio.ch1Vol < 0x0F && gb.audio.ch1EnvDir){
-								gb.audio.ch1Vol++;
-								gb.audio.ch1EnvCounter = gb.audio.ch1EnvCounterI;
-							}
-						}
-					}
-					
-					if(gb.audio.ch2EnvCounter){
-						if(--gb.audio.ch2EnvCounter == 0){
-							if(gb.audio.ch2Vol && !gb.audio.ch2EnvDir){
-								gb.audio.ch2Vol--;
-								gb.audio.ch2EnvCounter = gb.audio.ch2EnvCounterI;
-							}else if(gb.audio.ch2Vol < 0x0F && gb.audio.ch2EnvDir){
-								gb.audio.ch2Vol++;
-								gb.audio.ch2EnvCounter = gb.audio.ch2EnvCounterI;
-							}
-						}
-					}
-					
-					if(gb.audio.ch4EnvCounter){
-						if(--gb.audio.ch4EnvCounter == 0){
-							if(gb.audio.ch4Vol && !gb.audio.ch4EnvDir){
-								gb.audio.ch4Vol--;
-								gb.audio.ch4EnvCounter = gb.audio.ch4EnvCounterI;
-							}else if(gb.audio.ch4Vol < 0x0F && gb.audio.ch4EnvDir){
-								gb.audio.ch4Vol++;
-								gb.audio.ch4EnvCounter = gb.audio.ch4EnvCounterI;
-							}
-						}
-					}
+				if(clock_step(&frameClock, 1)){
+					mix_samples(mixed, i);  // The gains may change with what is left of the last frame
+					mixed = i;
+					if(fade_silent(&fade)) splice_song();
+					if(prerolling) engine_preroll(spare, INSTANCES);
+					if(!engine_consume_frame(playing, INSTANCES, false)) stats.lateFrames++;
 				}
 
-				if((apuCycle & 3) == 2){  // Sweep
-					if(gb.audio.ch1SweepCounterI && gb.audio.ch1SweepShift){
-						if(--gb.audio.ch1SweepCounter == 0){
-							gb.audio.ch1Freq = gb.hram[0x13] + ((gb.hram[0x14] & 7) << 8);
-							if(gb.audio.ch1SweepDir){
-								gb.audio.ch1Freq -= gb.audio.ch1Freq >> gb.audio.ch1SweepShift;
-								if(gb.audio.ch1Freq & 0xF800) gb.audio.ch1Freq = 0;
-							}else{
-								gb.audio.ch1Freq += gb.audio.ch1Freq >> gb.audio.ch1SweepShift;
-								if(gb.audio.ch1Freq & 0xF800){
-									gb.audio.ch1Freq = 0;
-									gb.audio.ch1EnvCounter = 0;
-									gb.audio.ch1Vol = 0;
-								}
-							}
-							gb.hram[0x13] = gb.audio.ch1Freq & 0xFF;
-							gb.hram[0x14] &= 0xF8;
-							gb.hram[0x14] += (gb.audio.ch1Freq >> 8) & 0x07;
-							gb.audio.ch1SweepCounter = gb.audio.ch1SweepCounterI;
-						}
-					}
+				if(engine_write_due(playing, INSTANCES)){
+					mix_samples(mixed, i);  // The gains may change with these writes
+					mixed = i;
+					engine_apply_writes(playing, INSTANCES);
 				}
+				engine_sample(playing, INSTANCES, i);
 			}
-			//Sound generation loop
-			soundChannelPos[0] += freqTable[gb.hram[0x13]+((gb.hram[0x14]&7)<<8)] / (SAMPLE_RATE / 32);
-			soundChannelPos[1] += freqTable[gb.hram[0x18]+((gb.hram[0x19]&7)<<8)] / (SAMPLE_RATE / 32);
-			soundChannelPos[2] += freqTable[gb.hram[0x1D]+((gb.hram[0x1E]&7)<<8)] / (SAMPLE_RATE / 32);
-			soundChannelPos[3] += freqTableNSE[gb.hram[0x22]] / (SAMPLE_RATE);
-			while(soundChannelPos[0] >= 32) soundChannelPos[0] -= 32;
-			while(soundChannelPos[1] >= 32) soundChannelPos[1] -= 32;
-			while(soundChannelPos[2] >= 32) soundChannelPos[2] -= 32;
-			while(soundChannelPos[3] >= PU4TableLen) soundChannelPos[3] = 0;
-			output[fillPos++] = 0;
-			output[fillPos--] = 0;
-			if(gb.hram[0x26] & 0x80){
-				soundChannel4Bit = 7 - (int)(soundChannelPos[3]) & 7;
-				if((gb.hram[0x25] & 0x01) && (gb.audio.ch1DAC) && (gb.hram[0x26] & 0x01)) output[fillPos] += gb.audio.ch1Vol * PU1Table[(int)(soundChannelPos[0])];
-				if((gb.hram[0x25] & 0x02) && (gb.audio.ch2DAC) && (gb.hram[0x26] & 0x02)) output[fillPos] += gb.audio.ch2Vol * PU2Table[(int)(soundChannelPos[1])];
-				if((gb.hram[0x25] & 0x04) && (gb.hram[0x1A] & 0x80) && (gb.hram[0x26] & 0x04)) output[fillPos] += gb.audio.WAVRAM[(int)(soundChannelPos[2])] >> gb.audio.ch3Vol;
-				if((gb.hram[0x25] & 0x08) && (gb.audio.ch4DAC) && (gb.hram[0x26] & 0x08)) output[fillPos] += gb.audio.ch4Vol * (((PU4Table[(int)(soundChannelPos[3]/8)] >> soundChannel4Bit) & 1) ? 1 : -1);
-				fillPos++;
-				if((gb.hram[0x25] & 0x10) && (gb.audio.ch1DAC) && (gb.hram[0x26] & 0x01)) output[fillPos] += gb.audio.ch1Vol * PU1Table[(int)(soundChannelPos[0])];
-				if((gb.hram[0x25] & 0x20) && (gb.audio.ch2DAC) && (gb.hram[0x26] & 0x02)) output[fillPos] += gb.audio.ch2Vol * PU2Table[(int)(soundChannelPos[1])];
-				if((gb.hram[0x25] & 0x40) && (gb.hram[0x1A] & 0x80) && (gb.hram[0x26] & 0x04)) output[fillPos] += gb.audio.WAVRAM[(int)(soundChannelPos[2])] >> gb.audio.ch3Vol;
-				if((gb.hram[0x25] & 0x80) && (gb.audio.ch4DAC) && (gb.hram[0x26] & 0x08)) output[fillPos] += gb.audio.ch4Vol * (((PU4Table[(int)(soundChannelPos[3]/8)] >> soundChannel4Bit) & 1) ? 1 : -1);
-			}else{
-				fillPos++;
-			}
-			if((output[fillPos] | output[fillPos - 1]) == 0){
-				if(++mutedTime >= MUTE_THRESHOLD) fadeout = 0;  // Setting fadeout to 0 will trigger the next song on the next gbframe
-			}else{
-				mutedTime = 0;
+			mix_samples(mixed, MIX_BLOCK);
+
+			filter_block(&filter, block, MIX_BLOCK);
+			n = resample_block(&resampler, block, MIX_BLOCK, resampled);
+			for(i = 0; i < n * 2; i++){
+				output[fillPos] = resampled[i];
+				if(++fillPos >= BUFFER_SIZE) fillPos -= BUFFER_SIZE;
 			}
-			if(++gb.audio.idleTimer >= MUTE_THRESHOLD) fadeout = 0;  // Setting fadeout to 0 will trigger the next song on the next gbframe
-			if(++fillPos >= BUFFER_SIZE) fillPos -= BUFFER_SIZE;
+			stats_mix(&stats, (STATS_NOW() - start) & STATS_TICK_MASK);
+		}else if(reportDue){
+			// The UART is slow: printing here keeps it out of the mix times, and off the buffer while it is low
+			reportDue = false;
+			stats_print(&report);
 		}else{
         __wfi(); // Wait for Interrupt
 		}
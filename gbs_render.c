@@ -0,0 +1,525 @@
+/*
+ * Host renderer. Runs the same producer/consumer pipeline as the Pico
+ * firmware, with the CPU emulation on its own thread, and writes the
+ * mixed output to an 8 bit WAV file (the same samples the PWM would get).
+ * The stats counters are printed after each song, with times measured on
+ * the host clock.
+ *
+ * Usage: gbs_render [-s song] [-a] [-l seconds] [-o out.wav] [-p] [-f hpf:lpf]
+ *                   [-r rate] [-S prefix] [-m channels] [-k kernel] [-x file.gbs[:song[:volume]]]... [-B seconds] [-G]
+ *                   [-F seconds[:curve]] [-w addr[:bytes]]...
+ *                   [-g golden.txt | -c golden.txt [-t n]] file.gbs
+ *
+ * -f sets the output filter cutoffs in Hz, 0 turns a filter off.
+ * -r sets the output rate, the mix is resampled to it if it is not
+ * SAMPLE_RATE.
+ * -S prefix also writes each channel's stem to prefix-ch1.wav to
+ * prefix-ch4.wav, from the same emulation run. Stems are 16 bit at
+ * SAMPLE_RATE, panned and at the master volume like in the mix, and taken
+ * before the output filter; the four of them add up to the mix.
+ * -m 13 plays only channels 1 and 3, -m 2 solos channel 2 and so on.
+ * -k picks the mix kernel (scalar, sse2, avx2 or neon) instead of the
+ * fastest one the CPU has. scalar is the reference the others must match.
+ * -x adds another GBS engine, mixed with the first: that file's song (its
+ * first song by default) at volume percent of full (100 by default), for
+ * layering sound effects over the music. It can be given up to
+ * MAX_INSTANCES - 1 times, and the time each render took is printed.
+ * -B times one engine of file.gbs on a single thread for that many seconds
+ * of the song, prints how many engines would fit in realtime and exits.
+ * -G renders the songs gaplessly like the player moves from one to the next:
+ * each song is pre-rolled during the last second of the one before and
+ * spliced in at the sample, without resetting the filter and resampler.
+ * -F fades each song out over its last seconds, like the player does, with
+ * the curve linear (the default), power (equal power) or exp (exponential).
+ *
+ * -p prints the opcode and memory access profile once all songs are done;
+ * it needs a build with GB_PROFILE defined (cmake -DGBS_PROFILE=ON).
+ * -w addr[:bytes] prints every write to the bytes from addr (hex, 1 byte by
+ * default) with the frame it was made in, to follow a driver's variables.
+ * It can be given up to MAX_WATCHES times, and needs a build with GB_WATCH
+ * defined (cmake -DGBS_WATCH=ON).
+ *
+ * Every song's output is hashed, as a whole and per second of audio.
+ * -g golden.txt saves those hashes, -c golden.txt renders again and
+ * compares against them, so changes to the CPU core or the mixer can be
+ * checked for being bit exact. -t n allows up to n seconds per song to
+ * differ. The exit status is 2 if the check fails.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define SAMPLE_RATE 44100  // Synthesis rate
+#define DEFAULT_LENGTH 90  // Default song length in seconds
+#define MIX_BLOCK 64  // Stereo samples mixed and filtered at a time
+#define FILTER_HPF_HZ 28
+#define FILTER_LPF_HZ 14000
+#ifndef FILTER_SCALAR  // Defined for the filter the Pico runs, see tests/CMakeLists.txt
+#define FILTER_SIMD
+#endif
+#define REG_QUEUE_IDLE() sched_yield()
+
+// Stats are kept in nanoseconds on the host
+#define STATS_NOW() host_now_ns()
+#define STATS_TICK_MASK 0xFFFFFFFF
+#define STATS_TICK_HZ 1000000000
+
+static uint32_t host_now_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Wall clock for timing whole renders, which the 32 bit stats ticks would wrap in
+static double host_seconds(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#include "tables.h"
+#include "stats.h"
+#include "reg_queue.h"
+#include "clock.h"
+#include "mix.h"
+#include "apu.h"
+#include "filter.h"
+#include "resample.h"
+#include "fade.h"
+#include "peanut_gb.h"
+#include "engine.h"
+#include "profile.h"
+#include "read_file.h"
+
+#define MAX_INSTANCES 8
+#define MAX_WATCHES 8
+
+static struct engine_s engines[2][MAX_INSTANCES];  // The song playing, and the next one pre-rolling with -G
+static struct engine_s *playing = engines[0], *spare = engines[1];
+static uint8_t *engineData[MAX_INSTANCES];  // The emulator reads the ROM from here, so it is kept until the end
+static int engineSong[MAX_INSTANCES];  // For the engines added with -x
+static uint32_t instances = 1;
+static struct fade_s fade;
+static uint32_t fadeSeconds;
+static enum fade_curve fadeCurve = FADE_LINEAR;
+static struct stats_s stats;
+static struct filter_s filter;
+static struct resample_s resampler;
+static FILE *stems[4];
+static volatile bool running = true;
+
+
+#ifdef GB_WATCH
+// Prints a write to bytes watched with -w
+static void print_write(struct gb_s *gb, uint16_t addr, uint8_t val, void *user){
+	(void)user;
+	printf("  frame %u: %04X = %02X\n", (unsigned)atomic_load(&gb->apu_queue->frames_produced), addr, val);
+}
+#endif
+
+
+static void *producer_thread(void *arg){
+	(void)arg;
+	while(running){
+		if(!(engine_produce(engines[0], instances) | engine_produce(engines[1], instances))) sched_yield();
+	}
+	return NULL;
+}
+
+
+// FNV-1a, 64 bit
+#define HASH_INIT 0xCBF29CE484222325ull
+
+static uint64_t hash_byte(uint64_t hash, uint8_t b){
+	return (hash ^ b) * 0x100000001B3ull;
+}
+
+
+static void write_u32(FILE *f, uint32_t v){
+	fputc(v, f); fputc(v >> 8, f); fputc(v >> 16, f); fputc(v >> 24, f);
+}
+
+
+// Stereo, bits is 8 or 16
+static void write_wav_header(FILE *f, uint32_t rate, uint32_t bits, uint32_t frames){
+	uint32_t frameSize = bits / 4;
+
+	fwrite("RIFF", 1, 4, f);
+	write_u32(f, 36 + frames * frameSize);
+	fwrite("WAVEfmt ", 1, 8, f);
+	write_u32(f, 16);
+	write_u32(f, 0x00020001);  // PCM, 2 channels
+	write_u32(f, rate);
+	write_u32(f, rate * frameSize);
+	write_u32(f, (bits << 16) | frameSize);
+	fwrite("data", 1, 4, f);
+	write_u32(f, frames * frameSize);
+}
+
+
+// Mixes samples from to to-1 of the block, and writes them to the stems if those are open.
+// A stem is that channel of every engine.
+static void mix_samples(int8_t *block, uint32_t from, uint32_t to){
+	engine_mix(playing, instances, from, to, &fade, &block[from * 2]);
+	if(!stems[0]) return;
+	for(int c = 0; c < 4; c++){
+		int32_t stem[MIX_BLOCK * 2] = {0};
+		for(uint32_t k = 0; k < instances; k++) apu_mix_channel(&playing[k].apu, c, from, to, stem);
+		for(uint32_t i = 0; i < (to - from) * 2; i++){
+			int16_t x = stem[i] > INT16_MAX ? INT16_MAX : (stem[i] < INT16_MIN ? INT16_MIN : stem[i]);
+			fputc(x, stems[c]);
+			fputc(x >> 8, stems[c]);
+		}
+	}
+}
+
+
+// Adds an engine playing name[:song[:volume]], returns false on failure
+static bool add_engine(const char *arg, struct stats_s *stats){
+	char name[1024];
+	int song = 0, volume = 100;
+	uint32_t size = 0;
+	uint8_t songs;
+
+	if(instances >= MAX_INSTANCES){
+		fprintf(stderr, "At most %d engines\n", MAX_INSTANCES);
+		return false;
+	}
+	snprintf(name, sizeof(name), "%s", arg);
+	if(strchr(name, ':')){
+		sscanf(strchr(name, ':') + 1, "%d:%d", &song, &volume);
+		*strchr(name, ':') = 0;
+	}
+	engineData[instances] = read_file(name, &size);
+	if(!engineData[instances]) return false;
+	for(int set = 0; set < 2; set++){
+		songs = engine_load(&engines[set][instances], engineData[instances], size, stats);
+		if(!songs){
+			fprintf(stderr, "%s: not a GBS file\n", name);
+			return false;
+		}
+		apu_set_volume(&engines[set][instances].apu, volume < 0 ? 0 : volume * 256 / 100);
+	}
+	engineSong[instances] = song > 0 && song <= songs ? song - 1 : engines[0][instances].gb.first_song;
+	instances++;
+	return true;
+}
+
+
+// Starts a song on a set of engines, the ones added with -x on their own songs
+static void request_song(struct engine_s *set, uint8_t song){
+	apu_request_song(&set[0].apu, &set[0].queue, song);
+	for(uint32_t k = 1; k < instances; k++) apu_request_song(&set[k].apu, &set[k].queue, engineSong[k]);
+}
+
+
+// Renders one song offline: the consumer waits for the producer instead of underrunning.
+// If next is a song, it is pre-rolled on the spare engines during the last second and
+// the next call carries on with it.
+// hashes[0] gets the hash of the whole song, hashes[1..seconds] that of each second.
+// Returns the number of stereo samples written.
+static uint32_t render_song(FILE *f, uint8_t song, int next, uint32_t seconds, uint64_t *hashes){
+	static bool prerolled;
+	struct engine_s *faded;
+	struct clock_s frameClock;  // Samples to frames
+	uint32_t samples = seconds * SAMPLE_RATE;
+	uint32_t written = 0;
+	int8_t block[MIX_BLOCK * 2];
+	int8_t resampled[RESAMPLE_MAX_OUT * 2];
+
+	hashes[0] = HASH_INIT;
+	for(uint32_t i = 1; i <= seconds; i++) hashes[i] = HASH_INIT;
+
+	if(!prerolled){
+		request_song(playing, song);
+		filter_reset(&filter);
+		resample_reset(&resampler);
+	}
+	prerolled = false;
+	fade_init(&fade);
+	clock_init_due(&frameClock, SAMPLE_RATE, CLOCK_FRAME_HZ);
+	for(uint32_t pos = 0; pos < samples; pos += MIX_BLOCK){
+		uint32_t n = samples - pos < MIX_BLOCK ? samples - pos : MIX_BLOCK;
+		uint32_t start = STATS_NOW();
+		uint32_t mixed = 0;
+
+		for(uint32_t i = 0; i < n; i++){
+			if(clock_step(&frameClock, 1)){
+				mix_samples(block, mixed, i);  // The gains may change with what is left of the last frame
+				mixed = i;
+				if(fadeSeconds && !fade.remaining && fade.gain && pos + i + fadeSeconds * SAMPLE_RATE >= samples){
+					fade_start(&fade, 0, samples - pos - i, fadeCurve);
+				}
+				if(next >= 0 && !prerolled && pos + i + SAMPLE_RATE >= samples){
+					request_song(spare, next);
+					prerolled = true;
+				}
+				if(prerolled) engine_preroll(spare, instances);
+				for(uint32_t k = 0; k < instances; k++){
+					if(!apu_frame_ready(&playing[k].apu, &playing[k].queue)) stats.lateFrames++;
+				}
+				engine_consume_frame(playing, instances, true);
+			}
+			if(engine_write_due(playing, instances)){
+				mix_samples(block, mixed, i);  // The gains may change with these writes
+				mixed = i;
+				engine_apply_writes(playing, instances);
+			}
+			engine_sample(playing, instances, i);
+		}
+		mix_samples(block, mixed, n);
+		filter_block(&filter, block, n);
+		n = resample_block(&resampler, block, n, resampled);
+		stats_mix(&stats, (STATS_NOW() - start) & STATS_TICK_MASK);
+
+		for(uint32_t i = 0; i < n * 2; i++){
+			uint8_t b = resampled[i] + 0x80;
+			uint32_t second = 1 + (written + i / 2) / resampler.rate;
+			if(second > seconds) second = seconds;
+			fputc(b, f);
+			hashes[0] = hash_byte(hashes[0], b);
+			hashes[second] = hash_byte(hashes[second], b);
+		}
+		written += n;
+	}
+
+	if(prerolled){
+		faded = playing;
+		playing = spare;
+		spare = faded;
+	}
+	return written;
+}
+
+
+// Line format: song number, length in seconds, whole song hash, hash of each second
+static void write_golden(FILE *f, uint8_t song, uint32_t seconds, const uint64_t *hashes){
+	fprintf(f, "%d %u", song + 1, seconds);
+	for(uint32_t i = 0; i <= seconds; i++) fprintf(f, " %016llx", (unsigned long long)hashes[i]);
+	fputc('\n', f);
+}
+
+
+// Returns true if the song matches its line in the golden file, allowing tolerance differing seconds
+static bool check_golden(FILE *f, uint8_t song, uint32_t seconds, const uint64_t *hashes, uint32_t tolerance){
+	int goldenSong;
+	uint32_t goldenSeconds;
+	unsigned long long hash;
+
+	rewind(f);
+	while(fscanf(f, "%d %u", &goldenSong, &goldenSeconds) == 2){
+		if(goldenSong != song + 1 || goldenSeconds != seconds){
+			fscanf(f, "%*[^\n]");
+			continue;
+		}
+
+		uint32_t differ = 0, first = 0;
+		for(uint32_t i = 0; i <= seconds; i++){
+			if(fscanf(f, "%llx", &hash) != 1 || hash != hashes[i]){
+				if(i && !differ++) first = i;
+			}
+		}
+		if(!differ){
+			printf("  matches golden output\n");
+			return true;
+		}
+		printf("  %u of %u seconds differ from golden output, first at %u s\n", differ, seconds, first - 1);
+		return differ <= tolerance;
+	}
+	printf("  no golden output for %u seconds of song %d\n", seconds, song + 1);
+	return false;
+}
+
+
+int main(int argc, char **argv){
+	const char *outName = "out.wav";
+	const char *inName = NULL;
+	int song = -1;
+	bool all = false;
+	bool profile = false;
+	const char *goldenName = NULL;
+	bool check = false;
+	uint32_t tolerance = 0;
+	uint32_t seconds = DEFAULT_LENGTH;
+	uint32_t hpfHz = FILTER_HPF_HZ, lpfHz = FILTER_LPF_HZ;
+	uint32_t rate = SAMPLE_RATE;
+	uint32_t frames = 0;
+	const char *kernel = NULL;
+	const char *stemPrefix = NULL;
+	uint8_t channelMask = 0x0F;
+	const char *layers[MAX_INSTANCES];
+	uint32_t layerCount = 0;
+	uint32_t benchmark = 0;
+	bool gapless = false;
+	uint32_t watches[MAX_WATCHES][2];
+	uint32_t watchCount = 0;
+
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-s") && i + 1 < argc) song = atoi(argv[++i]) - 1;
+		else if(!strcmp(argv[i], "-a")) all = true;
+		else if(!strcmp(argv[i], "-l") && i + 1 < argc) seconds = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-o") && i + 1 < argc) outName = argv[++i];
+		else if(!strcmp(argv[i], "-p")) profile = true;
+		else if(!strcmp(argv[i], "-f") && i + 1 < argc) sscanf(argv[++i], "%u:%u", &hpfHz, &lpfHz);
+		else if(!strcmp(argv[i], "-r") && i + 1 < argc) rate = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-k") && i + 1 < argc) kernel = argv[++i];
+		else if(!strcmp(argv[i], "-S") && i + 1 < argc) stemPrefix = argv[++i];
+		else if(!strcmp(argv[i], "-m") && i + 1 < argc){
+			channelMask = 0;
+			for(const char *c = argv[++i]; *c; c++){
+				if(*c >= '1' && *c <= '4') channelMask |= 1 << (*c - '1');
+			}
+		}
+		else if(!strcmp(argv[i], "-x") && i + 1 < argc){
+			if(layerCount < MAX_INSTANCES - 1) layers[layerCount] = argv[i + 1];
+			layerCount++;
+			i++;
+		}
+		else if(!strcmp(argv[i], "-B") && i + 1 < argc) benchmark = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-G")) gapless = true;
+		else if(!strcmp(argv[i], "-w") && i + 1 < argc){
+			if(watchCount == MAX_WATCHES){
+				fprintf(stderr, "At most %d watches\n", MAX_WATCHES);
+				return 1;
+			}
+			watches[watchCount][1] = 1;
+			sscanf(argv[++i], "%x:%u", &watches[watchCount][0], &watches[watchCount][1]);
+			watchCount++;
+		}
+		else if(!strcmp(argv[i], "-F") && i + 1 < argc){
+			const char *curve = strchr(argv[++i], ':');
+			fadeSeconds = atoi(argv[i]);
+			if(curve && !strcmp(curve + 1, "power")) fadeCurve = FADE_EQUAL_POWER;
+			else if(curve && !strcmp(curve + 1, "exp")) fadeCurve = FADE_EXPONENTIAL;
+		}
+		else if(!strcmp(argv[i], "-g") && i + 1 < argc) goldenName = argv[++i], check = false;
+		else if(!strcmp(argv[i], "-c") && i + 1 < argc) goldenName = argv[++i], check = true;
+		else if(!strcmp(argv[i], "-t") && i + 1 < argc) tolerance = atoi(argv[++i]);
+		else inName = argv[i];
+	}
+	if(!inName){
+		fprintf(stderr, "Usage: %s [-s song] [-a] [-l seconds] [-o out.wav] [-p] [-f hpf:lpf] [-r rate] [-S prefix] [-m channels] [-k kernel] [-x file.gbs[:song[:volume]]]... [-B seconds] [-G] [-F seconds[:curve]] [-g golden.txt | -c golden.txt [-t n]] file.gbs\n", argv[0]);
+		return 1;
+	}
+
+	if(!mix_select(kernel)){
+		fprintf(stderr, "Mix kernel %s is not available\n", kernel);
+		return 1;
+	}
+
+	uint32_t size = 0;
+	engineData[0] = read_file(inName, &size);
+	if(!engineData[0]) return 1;
+	uint8_t maxSongs = engine_load(&engines[0][0], engineData[0], size, &stats);
+	if(!maxSongs){
+		fprintf(stderr, "%s: not a GBS file\n", inName);
+		return 1;
+	}
+	engine_load(&engines[1][0], engineData[0], size, &stats);
+	if(song < 0 || song >= maxSongs) song = engines[0][0].gb.first_song;
+
+	if(benchmark){
+		uint32_t producer, consumer;
+		engine_benchmark(&engines[0][0], song, benchmark, &producer, &consumer);
+		printf("Producer %.2f ms/s, mixer %.2f ms/s per engine: %u engines fit on one core each\n",
+			producer / 1e6, consumer / 1e6, (unsigned)(STATS_TICK_HZ / (producer > consumer ? producer : consumer)));
+		return 0;
+	}
+	if(layerCount >= MAX_INSTANCES){
+		fprintf(stderr, "At most %d engines\n", MAX_INSTANCES);
+		return 1;
+	}
+	for(uint32_t i = 0; i < layerCount; i++){
+		if(!add_engine(layers[i], &stats)) return 1;
+	}
+	for(uint32_t k = 0; k < instances; k++){
+		apu_set_channel_mask(&engines[0][k].apu, channelMask);
+		apu_set_channel_mask(&engines[1][k].apu, channelMask);
+	}
+	for(uint32_t w = 0; w < watchCount; w++){
+#ifdef GB_WATCH
+		gb_watch_add(&engines[0][0].gb, watches[w][0], watches[w][1], print_write, NULL);
+		gb_watch_add(&engines[1][0].gb, watches[w][0], watches[w][1], print_write, NULL);
+#else
+		fprintf(stderr, "Watching writes needs a build with GB_WATCH defined\n");
+		return 1;
+#endif
+	}
+
+	FILE *out = fopen(outName, "wb");
+	if(!out){
+		perror(outName);
+		return 1;
+	}
+	FILE *golden = NULL;
+	if(goldenName){
+		golden = fopen(goldenName, check ? "r" : "w");
+		if(!golden){
+			perror(goldenName);
+			return 1;
+		}
+	}
+	for(int c = 0; stemPrefix && c < 4; c++){
+		char name[1024];
+		snprintf(name, sizeof(name), "%s-ch%d.wav", stemPrefix, c + 1);
+		stems[c] = fopen(name, "wb");
+		if(!stems[c]){
+			perror(name);
+			return 1;
+		}
+	}
+	uint64_t *hashes = malloc((seconds + 1) * sizeof(uint64_t));
+	bool passed = true;
+
+	uint8_t first = all ? 0 : song;
+	uint8_t last = all ? maxSongs - 1 : song;
+	filter_init(&filter, hpfHz, lpfHz);
+	rate = resample_init(&resampler, rate);
+	write_wav_header(out, rate, 8, 0);  // Rewritten with the length once done
+	for(int c = 0; c < 4 && stems[c]; c++) write_wav_header(stems[c], SAMPLE_RATE, 16, 0);
+
+	pthread_t producer;
+	pthread_create(&producer, NULL, producer_thread, NULL);
+	for(int s = first; s <= last; s++){
+		printf("Song %d/%d\n", s + 1, maxSongs);
+		stats_reset(&stats);
+		double start = host_seconds();
+		frames += render_song(out, s, gapless && s < last ? s + 1 : -1, seconds, hashes);
+		double took = host_seconds() - start;
+		stats_print(&stats);
+		if(instances > 1) printf("  %u engines, %.1fx realtime\n", instances, seconds / took);
+		printf("  hash %016llx\n", (unsigned long long)hashes[0]);
+		if(golden && check) passed &= check_golden(golden, s, seconds, hashes, tolerance);
+		else if(golden) write_golden(golden, s, seconds, hashes);
+	}
+	running = false;
+	pthread_join(producer, NULL);
+
+	if(profile){
+#ifdef GB_PROFILE
+		profile_print(&engines[0][0].gb, 20);
+#else
+		fprintf(stderr, "Profiling needs a build with GB_PROFILE defined\n");
+#endif
+	}
+
+	if(!fseek(out, 0, SEEK_SET)) write_wav_header(out, rate, 8, frames);
+	fclose(out);
+	for(int c = 0; c < 4 && stems[c]; c++){
+		if(!fseek(stems[c], 0, SEEK_SET)) write_wav_header(stems[c], SAMPLE_RATE, 16, (last - first + 1) * seconds * SAMPLE_RATE);
+		fclose(stems[c]);
+	}
+	if(golden) fclose(golden);
+	free(hashes);
+	for(uint32_t k = 0; k < instances; k++){
+		gb_free_sram(&engines[0][k].gb);
+		gb_free_sram(&engines[1][k].gb);
+		free(engineData[k]);
+	}
+	return passed ? 0 : 2;
+}
@@ -1,519 +0,0 @@
-const uint8_t lfsr7[] = {//pre-calculated noise 7-stage lfsr. LSb of last byte not used. Cycle in order of MSb to LSb
-	0xFE, 0x04, 0x18, 0x51, 0xE4, 0x59, 0xD4, 0xFA,
-	0x1C, 0x49, 0xB5, 0xBD, 0x8D, 0x2E, 0xE6, 0x54
-};
-
-const uint8_t lfsr15[] = {//pre-calculated noise 15-stage lfsr. LSb of last byte not used. Cycle in order of MSb to LSb
-	0xFF, 0xFE, 0x00, 0x04, 0x00, 0x18, 0x00, 0x50,
-	0x01, 0xE0, 0x04, 0x40, 0x19, 0x80, 0x55, 0x01,
-	0xFE, 0x04, 0x04, 0x18, 0x18, 0x50, 0x51, 0xE1,
-	0xE4, 0x44, 0x59, 0x99, 0xD5, 0x54, 0xFF, 0xFA,
-	0x00, 0x1C, 0x00, 0x48, 0x01, 0xB0, 0x05, 0xA0,
-	0x1D, 0xC0, 0x4C, 0x81, 0xAB, 0x05, 0xFA, 0x1C,
-	0x1C, 0x48, 0x49, 0xB1, 0xB5, 0xA5, 0xBD, 0xDD,
-	0x8C, 0xCD, 0x2A, 0xAE, 0xFF, 0xE6, 0x00, 0x54,
-	0x01, 0xF8, 0x04, 0x10, 0x18, 0x60, 0x51, 0x41,
-	0xE7, 0x84, 0x51, 0x19, 0xE6, 0x54, 0x55, 0xF9,
-	0xFC, 0x14, 0x08, 0x78, 0x31, 0x10, 0xA6, 0x63,
-	0xD5, 0x48, 0xFF, 0xB2, 0x01, 0xAC, 0x05, 0xE8,
-	0x1C, 0x70, 0x49, 0x21, 0xB6, 0xC5, 0xB6, 0x9D,
-	0xB7, 0x4D, 0xB3, 0xAD, 0xA9, 0xED, 0xF4, 0x6C,
-	0x39, 0x68, 0x97, 0x73, 0x73, 0x2B, 0x2A, 0xFA,
-	0xFE, 0x1E, 0x04, 0x44, 0x19, 0x98, 0x55, 0x51,
-	0xFF, 0xE4, 0x00, 0x58, 0x01, 0xD0, 0x04, 0xE0,
-	0x1A, 0x40, 0x5D, 0x81, 0xCD, 0x04, 0xAE, 0x1B,
-	0xE4, 0x58, 0x59, 0xD1, 0xD4, 0xE4, 0xFA, 0x5A,
-	0x1D, 0xDC, 0x4C, 0xC9, 0xAA, 0xB5, 0xFF, 0xBC,
-	0x01, 0x88, 0x05, 0x30, 0x1E, 0xA0, 0x47, 0xC1,
-	0x90, 0x85, 0x63, 0x1F, 0x4A, 0x43, 0xBD, 0x89,
-	0x8D, 0x35, 0x2E, 0xBE, 0xE7, 0x86, 0x51, 0x15,
-	0xE6, 0x7C, 0x55, 0x09, 0xFE, 0x34, 0x04, 0xB8,
-	0x1B, 0x90, 0x59, 0x61, 0xD7, 0x44, 0xF3, 0x9A,
-	0x29, 0x5C, 0xF7, 0xCA, 0x30, 0xBC, 0xA3, 0x8B,
-	0xC9, 0x38, 0xB6, 0x93, 0xB7, 0x69, 0xB3, 0x75,
-	0xAB, 0x3D, 0xFA, 0x8C, 0x1F, 0x28, 0x42, 0xF1,
-	0x8E, 0x25, 0x24, 0xDE, 0xDA, 0xC6, 0xDE, 0x96,
-	0xC7, 0x76, 0x93, 0x37, 0x6A, 0xB3, 0x7F, 0xAB,
-	0x01, 0xFA, 0x04, 0x1C, 0x18, 0x48, 0x51, 0xB1,
-	0xE5, 0xA4, 0x5D, 0xD9, 0xCC, 0xD4, 0xAA, 0xFB,
-	0xFE, 0x18, 0x04, 0x50, 0x19, 0xE0, 0x54, 0x41,
-	0xF9, 0x84, 0x15, 0x18, 0x7E, 0x51, 0x05, 0xE6,
-	0x1C, 0x54, 0x49, 0xF9, 0xB4, 0x15, 0xB8, 0x7D,
-	0x91, 0x0D, 0x66, 0x2F, 0x54, 0xE3, 0xFA, 0x48,
-	0x1D, 0xB0, 0x4D, 0xA1, 0xAD, 0xC5, 0xEC, 0x9C,
-	0x6B, 0x49, 0x7B, 0xB7, 0x19, 0xB2, 0x55, 0xAD,
-	0xFD, 0xEC, 0x0C, 0x68, 0x29, 0x70, 0xF7, 0x22,
-	0x32, 0xCC, 0xAE, 0xAB, 0xE7, 0xF8, 0x50, 0x11,
-	0xE0, 0x64, 0x41, 0x59, 0x87, 0xD5, 0x10, 0xFE,
-	0x62, 0x05, 0x4C, 0x1F, 0xA8, 0x41, 0xF1, 0x84,
-	0x25, 0x18, 0xDE, 0x52, 0xC5, 0xEE, 0x9C, 0x67,
-	0x49, 0x53, 0xB7, 0xE9, 0xB0, 0x75, 0xA1, 0x3D,
-	0xC6, 0x8C, 0x97, 0x2B, 0x72, 0xFB, 0x2E, 0x1A,
-	0xE4, 0x5E, 0x59, 0xC5, 0xD4, 0x9C, 0xFB, 0x4A,
-	0x1B, 0xBC, 0x59, 0x89, 0xD5, 0x34, 0xFE, 0xBA,
-	0x07, 0x9C, 0x11, 0x48, 0x67, 0xB1, 0x51, 0xA7,
-	0xE5, 0xD0, 0x5C, 0xE1, 0xCA, 0x44, 0xBD, 0x9B,
-	0x8D, 0x59, 0x2F, 0xD6, 0xE0, 0xF6, 0x42, 0x35,
-	0x8C, 0xBD, 0x2B, 0x8E, 0xF9, 0x26, 0x16, 0xD4,
-	0x76, 0xF9, 0x36, 0x16, 0xB4, 0x77, 0xB9, 0x31,
-	0x96, 0xA5, 0x77, 0xDF, 0x30, 0xC2, 0xA2, 0x8F,
-	0xCF, 0x20, 0xA2, 0xC3, 0xCE, 0x88, 0xA7, 0x33,
-	0xD2, 0xA8, 0xEF, 0xF2, 0x60, 0x2D, 0x40, 0xEF,
-	0x82, 0x61, 0x0D, 0x46, 0x2F, 0x94, 0xE1, 0x7A,
-	0x47, 0x1D, 0x92, 0x4D, 0x6D, 0xAF, 0x6D, 0xE3,
-	0x6C, 0x4B, 0x69, 0xBB, 0x75, 0x9B, 0x3D, 0x5A,
-	0x8F, 0xDF, 0x20, 0xC2, 0xC2, 0x8E, 0x8F, 0x27,
-	0x22, 0xD2, 0xCE, 0xEE, 0xA6, 0x67, 0xD5, 0x50,
-	0xFF, 0xE2, 0x00, 0x4C, 0x01, 0xA8, 0x05, 0xF0,
-	0x1C, 0x20, 0x48, 0xC1, 0xB2, 0x85, 0xAF, 0x1D,
-	0xE2, 0x4C, 0x4D, 0xA9, 0xAD, 0xF5, 0xEC, 0x3C,
-	0x68, 0x89, 0x73, 0x37, 0x2A, 0xB2, 0xFF, 0xAE,
-	0x01, 0xE4, 0x04, 0x58, 0x19, 0xD0, 0x54, 0xE1,
-	0xFA, 0x44, 0x1D, 0x98, 0x4D, 0x51, 0xAF, 0xE5,
-	0xE0, 0x5C, 0x41, 0xC9, 0x84, 0xB5, 0x1B, 0xBE,
-	0x59, 0x85, 0xD5, 0x1C, 0xFE, 0x4A, 0x05, 0xBC,
-	0x1D, 0x88, 0x4D, 0x31, 0xAE, 0xA5, 0xE7, 0xDC,
-	0x50, 0xC9, 0xE2, 0xB4, 0x4F, 0xB9, 0xA1, 0x95,
-	0xC5, 0x7C, 0x9F, 0x0B, 0x42, 0x3B, 0x8C, 0x99,
-	0x2B, 0x56, 0xFB, 0xF6, 0x18, 0x34, 0x50, 0xB9,
-	0xE3, 0x94, 0x49, 0x79, 0xB7, 0x15, 0xB2, 0x7D,
-	0xAD, 0x0D, 0xEE, 0x2C, 0x64, 0xE9, 0x5A, 0x77,
-	0xDD, 0x30, 0xCE, 0xA2, 0xA7, 0xCF, 0xD0, 0xA0,
-	0xE3, 0xC2, 0x48, 0x8D, 0xB3, 0x2D, 0xAA, 0xED,
-	0xFE, 0x6C, 0x05, 0x68, 0x1F, 0x70, 0x43, 0x21,
-	0x8A, 0xC5, 0x3E, 0x9E, 0x87, 0x47, 0x13, 0x92,
-	0x69, 0x6D, 0x77, 0x6F, 0x33, 0x62, 0xAB, 0x4F,
-	0xFB, 0xA0, 0x19, 0xC0, 0x54, 0x81, 0xFB, 0x04,
-	0x1A, 0x18, 0x5C, 0x51, 0xC9, 0xE4, 0xB4, 0x5B,
-	0xB9, 0xD9, 0x94, 0xD5, 0x7A, 0xFF, 0x1E, 0x02,
-	0x44, 0x0D, 0x98, 0x2D, 0x50, 0xEF, 0xE2, 0x60,
-	0x4D, 0x41, 0xAF, 0x85, 0xE1, 0x1C, 0x46, 0x49,
-	0x95, 0xB5, 0x7D, 0xBF, 0x0D, 0x82, 0x2D, 0x0C,
-	0xEE, 0x2A, 0x64, 0xFD, 0x5A, 0x0F, 0xDC, 0x20,
-	0xC8, 0xC2, 0xB2, 0x8F, 0xAF, 0x21, 0xE2, 0xC4,
-	0x4E, 0x99, 0xA7, 0x55, 0xD3, 0xFC, 0xE8, 0x0A,
-	0x70, 0x3D, 0x20, 0x8E, 0xC3, 0x26, 0x8A, 0xD7,
-	0x3E, 0xF2, 0x86, 0x2F, 0x14, 0xE2, 0x7A, 0x4D,
-	0x1D, 0xAE, 0x4D, 0xE5, 0xAC, 0x5D, 0xE9, 0xCC,
-	0x74, 0xA9, 0x3B, 0xF6, 0x98, 0x37, 0x50, 0xB3,
-	0xE3, 0xA8, 0x49, 0xF1, 0xB4, 0x25, 0xB8, 0xDD,
-	0x92, 0xCD, 0x6E, 0xAF, 0x67, 0xE3, 0x50, 0x4B,
-	0xE1, 0xB8, 0x45, 0x91, 0x9D, 0x65, 0x4F, 0x5F,
-	0xA3, 0xC1, 0xC8, 0x84, 0xB3, 0x1B, 0xAA, 0x59,
-	0xFD, 0xD4, 0x0C, 0xF8, 0x2A, 0x10, 0xFC, 0x62,
-	0x09, 0x4C, 0x37, 0xA8, 0xB1, 0xF3, 0xA4, 0x29,
-	0xD8, 0xF4, 0xD2, 0x3A, 0xEC, 0x9E, 0x6B, 0x45,
-	0x7B, 0x9F, 0x19, 0x42, 0x57, 0x8D, 0xF1, 0x2C,
-	0x26, 0xE8, 0xD6, 0x72, 0xF5, 0x2E, 0x3E, 0xE4,
-	0x86, 0x5B, 0x15, 0xDA, 0x7C, 0xDD, 0x0A, 0xCE,
-	0x3E, 0xA4, 0x87, 0xDB, 0x10, 0xDA, 0x62, 0xDD,
-	0x4E, 0xCF, 0xA6, 0xA1, 0xD7, 0xC4, 0xF0, 0x9A,
-	0x23, 0x5C, 0xCB, 0xCA, 0xB8, 0xBF, 0x93, 0x81,
-	0x69, 0x07, 0x76, 0x13, 0x34, 0x6A, 0xB9, 0x7F,
-	0x97, 0x01, 0x72, 0x07, 0x2C, 0x12, 0xE8, 0x6E,
-	0x71, 0x65, 0x27, 0x5E, 0xD3, 0xC6, 0xE8, 0x96,
-	0x73, 0x75, 0x2B, 0x3E, 0xFA, 0x86, 0x1F, 0x14,
-	0x42, 0x79, 0x8D, 0x15, 0x2E, 0x7E, 0xE5, 0x06,
-	0x5E, 0x15, 0xC4, 0x7C, 0x99, 0x0B, 0x56, 0x3B,
-	0xF4, 0x98, 0x3B, 0x50, 0x9B, 0xE3, 0x58, 0x4B,
-	0xD1, 0xB8, 0xE5, 0x92, 0x5D, 0x6D, 0xCF, 0x6C,
-	0xA3, 0x6B, 0xCB, 0x78, 0xBB, 0x13, 0x9A, 0x69,
-	0x5D, 0x77, 0xCF, 0x30, 0xA2, 0xA3, 0xCF, 0xC8,
-	0xA0, 0xB3, 0xC3, 0xA8, 0x89, 0xF3, 0x34, 0x2A,
-	0xB8, 0xFF, 0x92, 0x01, 0x6C, 0x07, 0x68, 0x13,
-	0x70, 0x6B, 0x21, 0x7A, 0xC7, 0x1E, 0x92, 0x47,
-	0x6D, 0x93, 0x6D, 0x6B, 0x6F, 0x7B, 0x63, 0x1B,
-	0x4A, 0x5B, 0xBD, 0xD9, 0x8C, 0xD5, 0x2A, 0xFE,
-	0xFE, 0x06, 0x04, 0x14, 0x18, 0x78, 0x51, 0x11,
-	0xE6, 0x64, 0x55, 0x59, 0xFF, 0xD4, 0x00, 0xF8,
-	0x02, 0x10, 0x0C, 0x60, 0x29, 0x40, 0xF7, 0x82,
-	0x31, 0x0C, 0xA6, 0x2B, 0xD4, 0xF8, 0xFA, 0x12,
-	0x1C, 0x6C, 0x49, 0x69, 0xB7, 0x75, 0xB3, 0x3D,
-	0xAA, 0x8D, 0xFF, 0x2C, 0x02, 0xE8, 0x0E, 0x70,
-	0x25, 0x20, 0xDE, 0xC2, 0xC6, 0x8E, 0x97, 0x27,
-	0x72, 0xD3, 0x2E, 0xEA, 0xE6, 0x7E, 0x55, 0x05,
-	0xFE, 0x1C, 0x04, 0x48, 0x19, 0xB0, 0x55, 0xA1,
-	0xFD, 0xC4, 0x0C, 0x98, 0x2B, 0x50, 0xFB, 0xE2,
-	0x18, 0x4C, 0x51, 0xA9, 0xE5, 0xF4, 0x5C, 0x39,
-	0xC8, 0x94, 0xB3, 0x7B, 0xAB, 0x19, 0xFA, 0x54,
-	0x1D, 0xF8, 0x4C, 0x11, 0xA8, 0x65, 0xF1, 0x5C,
-	0x27, 0xC8, 0xD0, 0xB2, 0xE3, 0xAE, 0x49, 0xE5,
-	0xB4, 0x5D, 0xB9, 0xCD, 0x94, 0xAD, 0x7B, 0xEF,
-	0x18, 0x62, 0x51, 0x4D, 0xE7, 0xAC, 0x51, 0xE9,
-	0xE4, 0x74, 0x59, 0x39, 0xD6, 0x94, 0xF7, 0x7A,
-	0x33, 0x1C, 0xAA, 0x4B, 0xFD, 0xB8, 0x0D, 0x90,
-	0x2D, 0x60, 0xEF, 0x42, 0x63, 0x8D, 0x49, 0x2F,
-	0xB6, 0xE1, 0xB6, 0x45, 0xB5, 0x9D, 0xBD, 0x4D,
-	0x8F, 0xAD, 0x21, 0xEE, 0xC4, 0x66, 0x99, 0x57,
-	0x57, 0xF3, 0xF0, 0x28, 0x20, 0xF0, 0xC2, 0x22,
-	0x8C, 0xCF, 0x2A, 0xA2, 0xFF, 0xCE, 0x00, 0xA4,
-	0x03, 0xD8, 0x08, 0xD0, 0x32, 0xE0, 0xAE, 0x43,
-	0xE5, 0x88, 0x5D, 0x31, 0xCE, 0xA4, 0xA7, 0xDB,
-	0xD0, 0xD8, 0xE2, 0xD2, 0x4E, 0xED, 0xA6, 0x6D,
-	0xD5, 0x6C, 0xFF, 0x6A, 0x03, 0x7C, 0x0B, 0x08,
-	0x3A, 0x30, 0x9C, 0xA3, 0x4B, 0xCB, 0xB8, 0xB9,
-	0x93, 0x95, 0x69, 0x7F, 0x77, 0x03, 0x32, 0x0A,
-	0xAC, 0x3F, 0xE8, 0x80, 0x73, 0x01, 0x2A, 0x06,
-	0xFC, 0x16, 0x08, 0x74, 0x31, 0x38, 0xA6, 0x93,
-	0xD7, 0x68, 0xF3, 0x72, 0x2B, 0x2C, 0xFA, 0xEA,
-	0x1E, 0x7C, 0x45, 0x09, 0x9E, 0x35, 0x44, 0xBF,
-	0x9B, 0x81, 0x59, 0x07, 0xD6, 0x10, 0xF4, 0x62,
-	0x39, 0x4C, 0x97, 0xAB, 0x71, 0xFB, 0x24, 0x1A,
-	0xD8, 0x5E, 0xD1, 0xC6, 0xE4, 0x96, 0x5B, 0x75,
-	0xDB, 0x3C, 0xDA, 0x8A, 0xDF, 0x3E, 0xC2, 0x86,
-	0x8F, 0x17, 0x22, 0x72, 0xCD, 0x2E, 0xAE, 0xE7,
-	0xE6, 0x50, 0x55, 0xE1, 0xFC, 0x44, 0x09, 0x98,
-	0x35, 0x50, 0xBF, 0xE3, 0x80, 0x49, 0x01, 0xB6,
-	0x05, 0xB4, 0x1D, 0xB8, 0x4D, 0x91, 0xAD, 0x65,
-	0xEF, 0x5C, 0x63, 0xC9, 0x48, 0xB7, 0xB3, 0xB1,
-	0xA9, 0xA5, 0xF5, 0xDC, 0x3C, 0xC8, 0x8A, 0xB3,
-	0x3F, 0xAA, 0x81, 0xFF, 0x04, 0x02, 0x18, 0x0C,
-	0x50, 0x29, 0xE0, 0xF4, 0x42, 0x39, 0x8C, 0x95,
-	0x2B, 0x7E, 0xFB, 0x06, 0x1A, 0x14, 0x5C, 0x79,
-	0xC9, 0x14, 0xB6, 0x7B, 0xB5, 0x19, 0xBE, 0x55,
-	0x85, 0xFD, 0x1C, 0x0E, 0x48, 0x25, 0xB0, 0xDD,
-	0xA2, 0xCD, 0xCE, 0xAC, 0xA7, 0xEB, 0xD0, 0x78,
-	0xE1, 0x12, 0x46, 0x6D, 0x95, 0x6D, 0x7F, 0x6F,
-	0x03, 0x62, 0x0B, 0x4C, 0x3B, 0xA8, 0x99, 0xF3,
-	0x54, 0x2B, 0xF8, 0xF8, 0x12, 0x10, 0x6C, 0x61,
-	0x69, 0x47, 0x77, 0x93, 0x31, 0x6A, 0xA7, 0x7F,
-	0xD3, 0x00, 0xEA, 0x02, 0x7C, 0x0D, 0x08, 0x2E,
-	0x30, 0xE4, 0xA2, 0x5B, 0xCD, 0xD8, 0xAC, 0xD3,
-	0xEA, 0xE8, 0x7E, 0x71, 0x05, 0x26, 0x1E, 0xD4,
-	0x46, 0xF9, 0x96, 0x15, 0x74, 0x7F, 0x39, 0x02,
-	0x96, 0x0F, 0x74, 0x23, 0x38, 0xCA, 0x92, 0xBF,
-	0x6F, 0x83, 0x61, 0x0B, 0x46, 0x3B, 0x94, 0x99,
-	0x7B, 0x57, 0x1B, 0xF2, 0x58, 0x2D, 0xD0, 0xEC,
-	0xE2, 0x6A, 0x4D, 0x7D, 0xAF, 0x0D, 0xE2, 0x2C,
-	0x4C, 0xE9, 0xAA, 0x75, 0xFD, 0x3C, 0x0E, 0x88,
-	0x27, 0x30, 0xD2, 0xA2, 0xEF, 0xCE, 0x60, 0xA5,
-	0x43, 0xDF, 0x88, 0xC1, 0x32, 0x86, 0xAF, 0x17,
-	0xE2, 0x70, 0x4D, 0x21, 0xAE, 0xC5, 0xE6, 0x9C,
-	0x57, 0x49, 0xF3, 0xB4, 0x29, 0xB8, 0xF5, 0x92,
-	0x3D, 0x6C, 0x8F, 0x6B, 0x23, 0x7A, 0xCB, 0x1E,
-	0xBA, 0x47, 0x9D, 0x91, 0x4D, 0x67, 0xAF, 0x51,
-	0xE3, 0xE4, 0x48, 0x59, 0xB1, 0xD5, 0xA4, 0xFD,
-	0xDA, 0x0C, 0xDC, 0x2A, 0xC8, 0xFE, 0xB2, 0x07,
-	0xAC, 0x11, 0xE8, 0x64, 0x71, 0x59, 0x27, 0xD6,
-	0xD0, 0xF6, 0xE2, 0x36, 0x4C, 0xB5, 0xAB, 0xBD,
-	0xF9, 0x8C, 0x15, 0x28, 0x7E, 0xF1, 0x06, 0x26,
-	0x14, 0xD4, 0x7A, 0xF9, 0x1E, 0x16, 0x44, 0x75,
-	0x99, 0x3D, 0x56, 0x8F, 0xF7, 0x20, 0x32, 0xC0,
-	0xAE, 0x83, 0xE7, 0x08, 0x52, 0x31, 0xEC, 0xA4,
-	0x6B, 0xD9, 0x78, 0xD7, 0x12, 0xF2, 0x6E, 0x2D,
-	0x64, 0xEF, 0x5A, 0x63, 0xDD, 0x48, 0xCF, 0xB2,
-	0xA1, 0xAF, 0xC5, 0xE0, 0x9C, 0x43, 0x49, 0x8B,
-	0xB5, 0x39, 0xBE, 0x95, 0x87, 0x7D, 0x13, 0x0E,
-	0x6A, 0x25, 0x7C, 0xDF, 0x0A, 0xC2, 0x3E, 0x8C,
-	0x87, 0x2B, 0x12, 0xFA, 0x6E, 0x1D, 0x64, 0x4F,
-	0x59, 0xA3, 0xD5, 0xC8, 0xFC, 0xB2, 0x0B, 0xAC,
-	0x39, 0xE8, 0x94, 0x73, 0x79, 0x2B, 0x16, 0xFA,
-	0x76, 0x1D, 0x34, 0x4E, 0xB9, 0xA7, 0x95, 0xD1,
-	0x7C, 0xE7, 0x0A, 0x52, 0x3D, 0xEC, 0x8C, 0x6B,
-	0x29, 0x7A, 0xF7, 0x1E, 0x32, 0x44, 0xAD, 0x9B,
-	0xED, 0x58, 0x6F, 0xD1, 0x60, 0xE7, 0x42, 0x53,
-	0x8D, 0xE9, 0x2C, 0x76, 0xE9, 0x36, 0x76, 0xB5,
-	0x37, 0xBE, 0xB1, 0x87, 0xA5, 0x11, 0xDE, 0x64,
-	0xC5, 0x5A, 0x9F, 0xDF, 0x40, 0xC3, 0x82, 0x89,
-	0x0F, 0x36, 0x22, 0xB4, 0xCF, 0xBA, 0xA1, 0x9F,
-	0xC5, 0x40, 0x9F, 0x83, 0x41, 0x0B, 0x86, 0x39,
-	0x14, 0x96, 0x7B, 0x75, 0x1B, 0x3E, 0x5A, 0x85,
-	0xDF, 0x1C, 0xC2, 0x4A, 0x8D, 0xBF, 0x2D, 0x82,
-	0xED, 0x0E, 0x6E, 0x25, 0x64, 0xDF, 0x5A, 0xC3,
-	0xDE, 0x88, 0xC7, 0x32, 0x92, 0xAF, 0x6F, 0xE3,
-	0x60, 0x4B, 0x41, 0xBB, 0x85, 0x99, 0x1D, 0x56,
-	0x4F, 0xF5, 0xA0, 0x3D, 0xC0, 0x8C, 0x83, 0x2B,
-	0x0A, 0xFA, 0x3E, 0x1C, 0x84, 0x4B, 0x19, 0xBA,
-	0x55, 0x9D, 0xFD, 0x4C, 0x0F, 0xA8, 0x21, 0xF0,
-	0xC4, 0x22, 0x98, 0xCF, 0x52, 0xA3, 0xEF, 0xC8,
-	0x60, 0xB1, 0x43, 0xA7, 0x89, 0xD1, 0x34, 0xE6,
-	0xBA, 0x57, 0x9D, 0xF1, 0x4C, 0x27, 0xA8, 0xD1,
-	0xF2, 0xE4, 0x2E, 0x58, 0xE5, 0xD2, 0x5C, 0xED,
-	0xCA, 0x6C, 0xBD, 0x6B, 0x8F, 0x79, 0x23, 0x16,
-	0xCA, 0x76, 0xBD, 0x37, 0x8E, 0xB1, 0x27, 0xA6,
-	0xD1, 0xD6, 0xE4, 0xF6, 0x5A, 0x35, 0xDC, 0xBC,
-	0xCB, 0x8A, 0xB9, 0x3F, 0x96, 0x81, 0x77, 0x07,
-	0x32, 0x12, 0xAC, 0x6F, 0xE9, 0x60, 0x77, 0x41,
-	0x33, 0x86, 0xA9, 0x17, 0xF6, 0x70, 0x35, 0x20,
-	0xBE, 0xC3, 0x86, 0x89, 0x17, 0x36, 0x72, 0xB5,
-	0x2F, 0xBE, 0xE1, 0x86, 0x45, 0x15, 0x9E, 0x7D,
-	0x45, 0x0F, 0x9E, 0x21, 0x44, 0xC7, 0x9A, 0x91,
-	0x5F, 0x67, 0xC3, 0x50, 0x8B, 0xE3, 0x38, 0x4A,
-	0x91, 0xBF, 0x65, 0x83, 0x5D, 0x0B, 0xCE, 0x38,
-	0xA4, 0x93, 0xDB, 0x68, 0xDB, 0x72, 0xDB, 0x2E,
-	0xDA, 0xE6, 0xDE, 0x56, 0xC5, 0xF6, 0x9C, 0x37,
-	0x48, 0xB3, 0xB3, 0xA9, 0xA9, 0xF5, 0xF4, 0x3C,
-	0x38, 0x88, 0x93, 0x33, 0x6A, 0xAB, 0x7F, 0xFB,
-	0x00, 0x1A, 0x00, 0x5C, 0x01, 0xC8, 0x04, 0xB0,
-	0x1B, 0xA0, 0x59, 0xC1, 0xD4, 0x84, 0xFB, 0x1A,
-	0x1A, 0x5C, 0x5D, 0xC9, 0xCC, 0xB4, 0xAB, 0xBB,
-	0xF9, 0x98, 0x15, 0x50, 0x7F, 0xE1, 0x00, 0x46,
-	0x01, 0x94, 0x05, 0x78, 0x1F, 0x10, 0x42, 0x61,
-	0x8D, 0x45, 0x2F, 0x9E, 0xE1, 0x46, 0x47, 0x95,
-	0x91, 0x7D, 0x67, 0x0F, 0x52, 0x23, 0xEC, 0xC8,
-	0x6A, 0xB1, 0x7F, 0xA7, 0x01, 0xD2, 0x04, 0xEC,
-	0x1A, 0x68, 0x5D, 0x71, 0xCF, 0x24, 0xA2, 0xDB,
-	0xCE, 0xD8, 0xA6, 0xD3, 0xD6, 0xE8, 0xF6, 0x72,
-	0x35, 0x2C, 0xBE, 0xEB, 0x86, 0x79, 0x15, 0x16,
-	0x7E, 0x75, 0x05, 0x3E, 0x1E, 0x84, 0x47, 0x19,
-	0x92, 0x55, 0x6D, 0xFF, 0x6C, 0x03, 0x68, 0x0B,
-	0x70, 0x3B, 0x20, 0x9A, 0xC3, 0x5E, 0x8B, 0xC7,
-	0x38, 0x92, 0x93, 0x6F, 0x6B, 0x63, 0x7B, 0x4B,
-	0x1B, 0xBA, 0x59, 0x9D, 0xD5, 0x4C, 0xFF, 0xAA,
-	0x01, 0xFC, 0x04, 0x08, 0x18, 0x30, 0x50, 0xA1,
-	0xE3, 0xC4, 0x48, 0x99, 0xB3, 0x55, 0xAB, 0xFD,
-	0xF8, 0x0C, 0x10, 0x28, 0x60, 0xF1, 0x42, 0x27,
-	0x8C, 0xD1, 0x2A, 0xE6, 0xFE, 0x56, 0x05, 0xF4,
-	0x1C, 0x38, 0x48, 0x91, 0xB3, 0x65, 0xAB, 0x5D,
-	0xFB, 0xCC, 0x18, 0xA8, 0x53, 0xF1, 0xE8, 0x24,
-	0x70, 0xD9, 0x22, 0xD6, 0xCE, 0xF6, 0xA6, 0x37,
-	0xD4, 0xB0, 0xFB, 0xA2, 0x19, 0xCC, 0x54, 0xA9,
-	0xFB, 0xF4, 0x18, 0x38, 0x50, 0x91, 0xE3, 0x64,
-	0x4B, 0x59, 0xBB, 0xD5, 0x98, 0xFD, 0x52, 0x0F,
-	0xEC, 0x20, 0x68, 0xC1, 0x72, 0x87, 0x2F, 0x12,
-	0xE2, 0x6E, 0x4D, 0x65, 0xAF, 0x5D, 0xE3, 0xCC,
-	0x48, 0xA9, 0xB3, 0xF5, 0xA8, 0x3D, 0xF0, 0x8C,
-	0x23, 0x28, 0xCA, 0xF2, 0xBE, 0x2F, 0x84, 0xE1,
-	0x1A, 0x46, 0x5D, 0x95, 0xCD, 0x7C, 0xAF, 0x0B,
-	0xE2, 0x38, 0x4C, 0x91, 0xAB, 0x65, 0xFB, 0x5C,
-	0x1B, 0xC8, 0x58, 0xB1, 0xD3, 0xA4, 0xE9, 0xDA,
-	0x74, 0xDD, 0x3A, 0xCE, 0x9E, 0xA7, 0x47, 0xD3,
-	0x90, 0xE9, 0x62, 0x77, 0x4D, 0x33, 0xAE, 0xA9,
-	0xE7, 0xF4, 0x50, 0x39, 0xE0, 0x94, 0x43, 0x79,
-	0x8B, 0x15, 0x3A, 0x7E, 0x9D, 0x07, 0x4E, 0x13,
-	0xA4, 0x69, 0xD9, 0x74, 0xD7, 0x3A, 0xF2, 0x9E,
-	0x2F, 0x44, 0xE3, 0x9A, 0x49, 0x5D, 0xB7, 0xCD,
-	0xB0, 0xAD, 0xA3, 0xED, 0xC8, 0x6C, 0xB1, 0x6B,
-	0xA7, 0x79, 0xD3, 0x14, 0xEA, 0x7A, 0x7D, 0x1D,
-	0x0E, 0x4E, 0x25, 0xA4, 0xDD, 0xDA, 0xCC, 0xDE,
-	0xAA, 0xC7, 0xFE, 0x90, 0x07, 0x60, 0x13, 0x40,
-	0x6B, 0x81, 0x79, 0x07, 0x16, 0x12, 0x74, 0x6D,
-	0x39, 0x6E, 0x97, 0x67, 0x73, 0x53, 0x2B, 0xEA,
-	0xF8, 0x7E, 0x11, 0x04, 0x66, 0x19, 0x54, 0x57,
-	0xF9, 0xF0, 0x14, 0x20, 0x78, 0xC1, 0x12, 0x86,
-	0x6F, 0x15, 0x62, 0x7F, 0x4D, 0x03, 0xAE, 0x09,
-	0xE4, 0x34, 0x58, 0xB9, 0xD3, 0x94, 0xE9, 0x7A,
-	0x77, 0x1D, 0x32, 0x4E, 0xAD, 0xA7, 0xED, 0xD0,
-	0x6C, 0xE1, 0x6A, 0x47, 0x7D, 0x93, 0x0D, 0x6A,
-	0x2F, 0x7C, 0xE3, 0x0A, 0x4A, 0x3D, 0xBC, 0x8D,
-	0x8B, 0x2D, 0x3A, 0xEE, 0x9E, 0x67, 0x45, 0x53,
-	0x9F, 0xE9, 0x40, 0x77, 0x81, 0x31, 0x06, 0xA6,
-	0x17, 0xD4, 0x70, 0xF9, 0x22, 0x16, 0xCC, 0x76,
-	0xA9, 0x37, 0xF6, 0xB0, 0x37, 0xA0, 0xB1, 0xC3,
-	0xA4, 0x89, 0xDB, 0x34, 0xDA, 0xBA, 0xDF, 0x9E,
-	0xC1, 0x46, 0x87, 0x97, 0x11, 0x72, 0x67, 0x2D,
-	0x52, 0xEF, 0xEE, 0x60, 0x65, 0x41, 0x5F, 0x87,
-	0xC1, 0x10, 0x86, 0x63, 0x15, 0x4A, 0x7F, 0xBD,
-	0x01, 0x8E, 0x05, 0x24, 0x1E, 0xD8, 0x46, 0xD1,
-	0x96, 0xE5, 0x76, 0x5F, 0x35, 0xC2, 0xBC, 0x8F,
-	0x8B, 0x21, 0x3A, 0xC6, 0x9E, 0x97, 0x47, 0x73,
-	0x93, 0x29, 0x6A, 0xF7, 0x7E, 0x33, 0x04, 0xAA,
-	0x1B, 0xFC, 0x58, 0x09, 0xD0, 0x34, 0xE0, 0xBA,
-	0x43, 0x9D, 0x89, 0x4D, 0x37, 0xAE, 0xB1, 0xE7,
-	0xA4, 0x51, 0xD9, 0xE4, 0xD4, 0x5A, 0xF9, 0xDE,
-	0x14, 0xC4, 0x7A, 0x99, 0x1F, 0x56, 0x43, 0xF5,
-	0x88, 0x3D, 0x30, 0x8E, 0xA3, 0x27, 0xCA, 0xD0,
-	0xBE, 0xE3, 0x86, 0x49, 0x15, 0xB6, 0x7D, 0xB5,
-	0x0D, 0xBE, 0x2D, 0x84, 0xED, 0x1A, 0x6E, 0x5D,
-	0x65, 0xCF, 0x5C, 0xA3, 0xCB, 0xC8, 0xB8, 0xB3,
-	0x93, 0xA9, 0x69, 0xF7, 0x74, 0x33, 0x38, 0xAA,
-	0x93, 0xFF, 0x68, 0x03, 0x70, 0x0B, 0x20, 0x3A,
-	0xC0, 0x9E, 0x83, 0x47, 0x0B, 0x92, 0x39, 0x6C,
-	0x97, 0x6B, 0x73, 0x7B, 0x2B, 0x1A, 0xFA, 0x5E,
-	0x1D, 0xC4, 0x4C, 0x99, 0xAB, 0x55, 0xFB, 0xFC,
-	0x18, 0x08, 0x50, 0x31, 0xE0, 0xA4, 0x43, 0xD9,
-	0x88, 0xD5, 0x32, 0xFE, 0xAE, 0x07, 0xE4, 0x10,
-	0x58, 0x61, 0xD1, 0x44, 0xE7, 0x9A, 0x51, 0x5D,
-	0xE7, 0xCC, 0x50, 0xA9, 0xE3, 0xF4, 0x48, 0x39,
-	0xB0, 0x95, 0xA3, 0x7D, 0xCB, 0x0C, 0xBA, 0x2B,
-	0x9C, 0xF9, 0x4A, 0x17, 0xBC, 0x71, 0x89, 0x25,
-	0x36, 0xDE, 0xB6, 0xC7, 0xB6, 0x91, 0xB7, 0x65,
-	0xB3, 0x5D, 0xAB, 0xCD, 0xF8, 0xAC, 0x13, 0xE8,
-	0x68, 0x71, 0x71, 0x27, 0x26, 0xD2, 0xD6, 0xEE,
-	0xF6, 0x66, 0x35, 0x54, 0xBF, 0xFB, 0x80, 0x19,
-	0x00, 0x56, 0x01, 0xF4, 0x04, 0x38, 0x18, 0x90,
-	0x53, 0x61, 0xEB, 0x44, 0x7B, 0x99, 0x19, 0x56,
-	0x57, 0xF5, 0xF0, 0x3C, 0x20, 0x88, 0xC3, 0x32,
-	0x8A, 0xAF, 0x3F, 0xE2, 0x80, 0x4F, 0x01, 0xA2,
-	0x05, 0xCC, 0x1C, 0xA8, 0x4B, 0xF1, 0xB8, 0x25,
-	0x90, 0xDD, 0x62, 0xCF, 0x4E, 0xA3, 0xA7, 0xC9,
-	0xD0, 0xB4, 0xE3, 0xBA, 0x49, 0x9D, 0xB5, 0x4D,
-	0xBF, 0xAD, 0x81, 0xED, 0x04, 0x6E, 0x19, 0x64,
-	0x57, 0x59, 0xF3, 0xD4, 0x28, 0xF8, 0xF2, 0x12,
-	0x2C, 0x6C, 0xE9, 0x6A, 0x77, 0x7D, 0x33, 0x0E,
-	0xAA, 0x27, 0xFC, 0xD0, 0x0A, 0xE0, 0x3E, 0x40,
-	0x85, 0x83, 0x1D, 0x0A, 0x4E, 0x3D, 0xA4, 0x8D,
-	0xDB, 0x2C, 0xDA, 0xEA, 0xDE, 0x7E, 0xC5, 0x06,
-	0x9E, 0x17, 0x44, 0x73, 0x99, 0x29, 0x56, 0xF7,
-	0xF6, 0x30, 0x34, 0xA0, 0xBB, 0xC3, 0x98, 0x89,
-	0x53, 0x37, 0xEA, 0xB0, 0x7F, 0xA1, 0x01, 0xC6,
-	0x04, 0x94, 0x1B, 0x78, 0x5B, 0x11, 0xDA, 0x64,
-	0xDD, 0x5A, 0xCF, 0xDE, 0xA0, 0xC7, 0xC2, 0x90,
-	0x8F, 0x63, 0x23, 0x4A, 0xCB, 0xBE, 0xB9, 0x87,
-	0x95, 0x11, 0x7E, 0x67, 0x05, 0x52, 0x1F, 0xEC,
-	0x40, 0x69, 0x81, 0x75, 0x07, 0x3E, 0x12, 0x84,
-	0x6F, 0x19, 0x62, 0x57, 0x4D, 0xF3, 0xAC, 0x29,
-	0xE8, 0xF4, 0x72, 0x39, 0x2C, 0x96, 0xEB, 0x76,
-	0x7B, 0x35, 0x1A, 0xBE, 0x5F, 0x85, 0xC1, 0x1C,
-	0x86, 0x4B, 0x15, 0xBA, 0x7D, 0x9D, 0x0D, 0x4E,
-	0x2F, 0xA4, 0xE1, 0xDA, 0x44, 0xDD, 0x9A, 0xCD,
-	0x5E, 0xAF, 0xC7, 0xE0, 0x90, 0x43, 0x61, 0x8B,
-	0x45, 0x3B, 0x9E, 0x99, 0x47, 0x57, 0x93, 0xF1,
-	0x68, 0x27, 0x70, 0xD3, 0x22, 0xEA, 0xCE, 0x7E,
-	0xA5, 0x07, 0xDE, 0x10, 0xC4, 0x62, 0x99, 0x4F,
-	0x57, 0xA3, 0xF1, 0xC8, 0x24, 0xB0, 0xDB, 0xA2,
-	0xD9, 0xCE, 0xD4, 0xA6, 0xFB, 0xD6, 0x18, 0xF4,
-	0x52, 0x39, 0xEC, 0x94, 0x6B, 0x79, 0x7B, 0x17,
-	0x1A, 0x72, 0x5D, 0x2D, 0xCE, 0xEC, 0xA6, 0x6B,
-	0xD5, 0x78, 0xFF, 0x12, 0x02, 0x6C, 0x0D, 0x68,
-	0x2F, 0x70, 0xE3, 0x22, 0x4A, 0xCD, 0xBE, 0xAD,
-	0x87, 0xED, 0x10, 0x6E, 0x61, 0x65, 0x47, 0x5F,
-	0x93, 0xC1, 0x68, 0x87, 0x73, 0x13, 0x2A, 0x6A,
-	0xFD, 0x7E, 0x0F, 0x04, 0x22, 0x18, 0xCC, 0x52,
-	0xA9, 0xEF, 0xF4, 0x60, 0x39, 0x40, 0x97, 0x83,
-	0x71, 0x0B, 0x26, 0x3A, 0xD4, 0x9E, 0xFB, 0x46,
-	0x1B, 0x94, 0x59, 0x79, 0xD7, 0x14, 0xF2, 0x7A,
-	0x2D, 0x1C, 0xEE, 0x4A, 0x65, 0xBD, 0x5D, 0x8F,
-	0xCD, 0x20, 0xAE, 0xC3, 0xE6, 0x88, 0x57, 0x31,
-	0xF2, 0xA4, 0x2F, 0xD8, 0xE0, 0xD2, 0x42, 0xED,
-	0x8E, 0x6D, 0x25, 0x6E, 0xDF, 0x66, 0xC3, 0x56,
-	0x8B, 0xF7, 0x38, 0x32, 0x90, 0xAF, 0x63, 0xE3,
-	0x48, 0x4B, 0xB1, 0xB9, 0xA5, 0x95, 0xDD, 0x7C,
-	0xCF, 0x0A, 0xA2, 0x3F, 0xCC, 0x80, 0xAB, 0x03,
-	0xFA, 0x08, 0x1C, 0x30, 0x48, 0xA1, 0xB3, 0xC5,
-	0xA8, 0x9D, 0xF3, 0x4C, 0x2B, 0xA8, 0xF9, 0xF2,
-	0x14, 0x2C, 0x78, 0xE9, 0x12, 0x76, 0x6D, 0x35,
-	0x6E, 0xBF, 0x67, 0x83, 0x51, 0x0B, 0xE6, 0x38,
-	0x54, 0x91, 0xFB, 0x64, 0x1B, 0x58, 0x5B, 0xD1,
-	0xD8, 0xE4, 0xD2, 0x5A, 0xED, 0xDE, 0x6C, 0xC5,
-	0x6A, 0x9F, 0x7F, 0x43, 0x03, 0x8A, 0x09, 0x3C,
-	0x36, 0x88, 0xB7, 0x33, 0xB2, 0xA9, 0xAF, 0xF5,
-	0xE0, 0x3C, 0x40, 0x89, 0x83, 0x35, 0x0A, 0xBE,
-	0x3F, 0x84, 0x81, 0x1B, 0x06, 0x5A, 0x15, 0xDC,
-	0x7C, 0xC9, 0x0A, 0xB6, 0x3F, 0xB4, 0x81, 0xBB,
-	0x05, 0x9A, 0x1D, 0x5C, 0x4F, 0xC9, 0xA0, 0xB5,
-	0xC3, 0xBC, 0x89, 0x8B, 0x35, 0x3A, 0xBE, 0x9F,
-	0x87, 0x41, 0x13, 0x86, 0x69, 0x15, 0x76, 0x7F,
-	0x35, 0x02, 0xBE, 0x0F, 0x84, 0x21, 0x18, 0xC6,
-	0x52, 0x95, 0xEF, 0x7C, 0x63, 0x09, 0x4A, 0x37,
-	0xBC, 0xB1, 0x8B, 0xA5, 0x39, 0xDE, 0x94, 0xC7,
-	0x7A, 0x93, 0x1F, 0x6A, 0x43, 0x7D, 0x8B, 0x0D,
-	0x3A, 0x2E, 0x9C, 0xE7, 0x4A, 0x53, 0xBD, 0xE9,
-	0x8C, 0x75, 0x29, 0x3E, 0xF6, 0x86, 0x37, 0x14,
-	0xB2, 0x7B, 0xAD, 0x19, 0xEE, 0x54, 0x65, 0xF9,
-	0x5C, 0x17, 0xC8, 0x70, 0xB1, 0x23, 0xA6, 0xC9,
-	0xD6, 0xB4, 0xF7, 0xBA, 0x31, 0x9C, 0xA5, 0x4B,
-	0xDF, 0xB8, 0xC1, 0x92, 0x85, 0x6F, 0x1F, 0x62,
-	0x43, 0x4D, 0x8B, 0xAD, 0x39, 0xEE, 0x94, 0x67,
-	0x79, 0x53, 0x17, 0xEA, 0x70, 0x7D, 0x21, 0x0E,
-	0xC6, 0x26, 0x94, 0xD7, 0x7A, 0xF3, 0x1E, 0x2A,
-	0x44, 0xFD, 0x9A, 0x0D, 0x5C, 0x2F, 0xC8, 0xE0,
-	0xB2, 0x43, 0xAD, 0x89, 0xED, 0x34, 0x6E, 0xB9,
-	0x67, 0x97, 0x51, 0x73, 0xE7, 0x28, 0x52, 0xF1,
-	0xEE, 0x24, 0x64, 0xD9, 0x5A, 0xD7, 0xDE, 0xF0,
-	0xC6, 0x22, 0x94, 0xCF, 0x7A, 0xA3, 0x1F, 0xCA,
-	0x40, 0xBD, 0x83, 0x8D, 0x09, 0x2E, 0x36, 0xE4,
-	0xB6, 0x5B, 0xB5, 0xD9, 0xBC, 0xD5, 0x8A, 0xFD,
-	0x3E, 0x0E, 0x84, 0x27, 0x18, 0xD2, 0x52, 0xED,
-	0xEE, 0x6C, 0x65, 0x69, 0x5F, 0x77, 0xC3, 0x30,
-	0x8A, 0xA3, 0x3F, 0xCA, 0x80, 0xBF, 0x03, 0x82,
-	0x09, 0x0C, 0x36, 0x28, 0xB4, 0xF3, 0xBA, 0x29,
-	0x9C, 0xF5, 0x4A, 0x3F, 0xBC, 0x81, 0x8B, 0x05,
-	0x3A, 0x1E, 0x9C, 0x47, 0x49, 0x93, 0xB5, 0x69,
-	0xBF, 0x75, 0x83, 0x3D, 0x0A, 0x8E, 0x3F, 0x24,
-	0x82, 0xDB, 0x0E, 0xDA, 0x26, 0xDC, 0xD6, 0xCA,
-	0xF6, 0xBE, 0x37, 0x84, 0xB1, 0x1B, 0xA6, 0x59,
-	0xD5, 0xD4, 0xFC, 0xFA, 0x0A, 0x1C, 0x3C, 0x48,
-	0x89, 0xB3, 0x35, 0xAA, 0xBD, 0xFF, 0x8C, 0x01,
-	0x28, 0x06, 0xF0, 0x16, 0x20, 0x74, 0xC1, 0x3A,
-	0x86, 0x9F, 0x17, 0x42, 0x73, 0x8D, 0x29, 0x2E,
-	0xF6, 0xE6, 0x36, 0x54, 0xB5, 0xFB, 0xBC, 0x19,
-	0x88, 0x55, 0x31, 0xFE, 0xA4, 0x07, 0xD8, 0x10,
-	0xD0, 0x62, 0xE1, 0x4E, 0x47, 0xA5, 0x91, 0xDD,
-	0x64, 0xCF, 0x5A, 0xA3, 0xDF, 0xC8, 0xC0, 0xB2,
-	0x83, 0xAF, 0x09, 0xE2, 0x34, 0x4C, 0xB9, 0xAB,
-	0x95, 0xF9, 0x7C, 0x17, 0x08, 0x72, 0x31, 0x2C,
-	0xA6, 0xEB, 0xD6, 0x78, 0xF5, 0x12, 0x3E, 0x6C,
-	0x85, 0x6B, 0x1F, 0x7A, 0x43, 0x1D, 0x8A, 0x4D,
-	0x3D, 0xAE, 0x8D, 0xE7, 0x2C, 0x52, 0xE9, 0xEE,
-	0x74, 0x65, 0x39, 0x5E, 0x97, 0xC7, 0x70, 0x93,
-	0x23, 0x6A, 0xCB, 0x7E, 0xBB, 0x07, 0x9A, 0x11,
-	0x5C, 0x67, 0xC9, 0x50, 0xB7, 0xE3, 0xB0, 0x49,
-	0xA1, 0xB5, 0xC5, 0xBC, 0x9D, 0x8B, 0x4D, 0x3B,
-	0xAE, 0x99, 0xE7, 0x54, 0x53, 0xF9, 0xE8, 0x14,
-	0x70, 0x79, 0x21, 0x16, 0xC6, 0x76, 0x95, 0x37,
-	0x7E, 0xB3, 0x07, 0xAA, 0x11, 0xFC, 0x64, 0x09,
-	0x58, 0x37, 0xD0, 0xB0, 0xE3, 0xA2, 0x49, 0xCD,
-	0xB4, 0xAD, 0xBB, 0xED, 0x98, 0x6D, 0x51, 0x6F,
-	0xE7, 0x60, 0x53, 0x41, 0xEB, 0x84, 0x79, 0x19,
-	0x16, 0x56, 0x75, 0xF5, 0x3C, 0x3E, 0x88, 0x87,
-	0x33, 0x12, 0xAA, 0x6F, 0xFD, 0x60, 0x0F, 0x40,
-	0x23, 0x80, 0xC9, 0x02, 0xB6, 0x0F, 0xB4, 0x21,
-	0xB8, 0xC5, 0x92, 0x9D, 0x6F, 0x4F, 0x63, 0xA3,
-	0x49, 0xCB, 0xB4, 0xB9, 0xBB, 0x95, 0x99, 0x7D,
-	0x57, 0x0F, 0xF2, 0x20, 0x2C, 0xC0, 0xEA, 0x82,
-	0x7F, 0x0D, 0x02, 0x2E, 0x0C, 0xE4, 0x2A, 0x58,
-	0xFD, 0xD2, 0x0C, 0xEC, 0x2A, 0x68, 0xFD, 0x72,
-	0x0F, 0x2C, 0x22, 0xE8, 0xCE, 0x72, 0xA5, 0x2F,
-	0xDE, 0xE0, 0xC6, 0x42, 0x95, 0x8F, 0x7D, 0x23,
-	0x0E, 0xCA, 0x26, 0xBC, 0xD7, 0x8A, 0xF1, 0x3E,
-	0x26, 0x84, 0xD7, 0x1A, 0xF2, 0x5E, 0x2D, 0xC4,
-	0xEC, 0x9A, 0x6B, 0x5D, 0x7B, 0xCF, 0x18, 0xA2,
-	0x53, 0xCD, 0xE8, 0xAC, 0x73, 0xE9, 0x28, 0x76,
-	0xF1, 0x36, 0x26, 0xB4, 0xD7, 0xBA, 0xF1, 0x9E,
-	0x25, 0x44, 0xDF, 0x9A, 0xC1, 0x5E, 0x87, 0xC7,
-	0x10, 0x92, 0x63, 0x6D, 0x4B, 0x6F, 0xBB, 0x61,
-	0x9B, 0x45, 0x5B, 0x9F, 0xD9, 0x40, 0xD7, 0x82,
-	0xF1, 0x0E, 0x26, 0x24, 0xD4, 0xDA, 0xFA, 0xDE,
-	0x1E, 0xC4, 0x46, 0x99, 0x97, 0x55, 0x73, 0xFF,
-	0x28, 0x02, 0xF0, 0x0E, 0x20, 0x24, 0xC0, 0xDA,
-	0x82, 0xDF, 0x0E, 0xC2, 0x26, 0x8C, 0xD7, 0x2A,
-	0xF2, 0xFE, 0x2E, 0x04, 0xE4, 0x1A, 0x58, 0x5D,
-	0xD1, 0xCC, 0xE4, 0xAA, 0x5B, 0xFD, 0xD8, 0x0C,
-	0xD0, 0x2A, 0xE0, 0xFE, 0x42, 0x05, 0x8C, 0x1D,
-	0x28, 0x4E, 0xF1, 0xA6, 0x25, 0xD4, 0xDC, 0xFA,
-	0xCA, 0x1E, 0xBC, 0x47, 0x89, 0x91, 0x35, 0x66,
-	0xBF, 0x57, 0x83, 0xF1, 0x08, 0x26, 0x30, 0xD4,
-	0xA2, 0xFB, 0xCE, 0x18, 0xA4, 0x53, 0xD9, 0xE8,
-	0xD4, 0x72, 0xF9, 0x2E, 0x16, 0xE4, 0x76, 0x59,
-	0x35, 0xD6, 0xBC, 0xF7, 0x8A, 0x31, 0x3C, 0xA6,
-	0x8B, 0xD7, 0x38, 0xF2, 0x92, 0x2F, 0x6C, 0xE3,
-	0x6A, 0x4B, 0x7D, 0xBB, 0x0D, 0x9A, 0x2D, 0x5C,
-	0xEF, 0xCA, 0x60, 0xBD, 0x43, 0x8F, 0x89, 0x21,
-	0x36, 0xC6, 0xB6, 0x97, 0xB7, 0x71, 0xB3, 0x25,
-	0xAA, 0xDD, 0xFE, 0xCC, 0x06, 0xA8, 0x17, 0xF0,
-	0x70, 0x21, 0x20, 0xC6, 0xC2, 0x96, 0x8F, 0x77,
-	0x23, 0x32, 0xCA, 0xAE, 0xBF, 0xE7, 0x80, 0x51,
-	0x01, 0xE6, 0x04, 0x54, 0x19, 0xF8, 0x54, 0x11,
-	0xF8, 0x64, 0x11, 0x58, 0x67, 0xD1, 0x50, 0xE7,
-	0xE2, 0x50, 0x4D, 0xE1, 0xAC, 0x45, 0xE9, 0x9C,
-	0x75, 0x49, 0x3F, 0xB6, 0x81, 0xB7, 0x05, 0xB2,
-	0x1D, 0xAC, 0x4D, 0xE9, 0xAC, 0x75, 0xE9, 0x3C,
-	0x76, 0x89, 0x37, 0x36, 0xB2, 0xB7, 0xAF, 0xB1,
-	0xE1, 0xA4, 0x45, 0xD9, 0x9C, 0xD5, 0x4A, 0xFF,
-	0xBE, 0x01, 0x84, 0x05, 0x18, 0x1E, 0x50, 0x45,
-	0xE1, 0x9C, 0x45, 0x49, 0x9F, 0xB5, 0x41, 0xBF,
-	0x85, 0x81, 0x1D, 0x06, 0x4E, 0x15, 0xA4, 0x7D,
-	0xD9, 0x0C, 0xD6, 0x2A, 0xF4, 0xFE, 0x3A, 0x04,
-	0x9C, 0x1B, 0x48, 0x5B, 0xB1, 0xD9, 0xA4, 0xD5,
-	0xDA, 0xFC, 0xDE, 0x0A, 0xC4, 0x3E, 0x98, 0x87,
-	0x53, 0x13, 0xEA, 0x68, 0x7D, 0x71, 0x0F, 0x26,
-	0x22, 0xD4, 0xCE, 0xFA, 0xA6, 0x1F, 0xD4, 0x40,
-	0xF9, 0x82, 0x15, 0x0C, 0x7E, 0x29, 0x04, 0xF6,
-	0x1A, 0x34, 0x5C, 0xB9, 0xCB, 0x94, 0xB9, 0x7B,
-	0x97, 0x19, 0x72, 0x57, 0x2D, 0xF2, 0xEC, 0x2E,
-	0x68, 0xE5, 0x72, 0x5F, 0x2D, 0xC2, 0xEC, 0x8E,
-	0x6B, 0x25, 0x7A, 0xDF, 0x1E, 0xC2, 0x46, 0x8D,
-	0x97, 0x2D, 0x72, 0xEF, 0x2E, 0x62, 0xE5, 0x4E,
-	0x5F, 0xA5, 0xC1, 0xDC, 0x84, 0xCB, 0x1A, 0xBA,
-	0x5F, 0x9D, 0xC1, 0x4C, 0x87, 0xAB, 0x11, 0xFA,
-	0x64, 0x1D, 0x58, 0x4F, 0xD1, 0xA0, 0xE5, 0xC2,
-	0x5C, 0x8D, 0xCB, 0x2C, 0xBA, 0xEB, 0x9E, 0x79,
-	0x45, 0x17, 0x9E, 0x71, 0x45, 0x27, 0x9E, 0xD1,
-	0x46, 0xE7, 0x96, 0x51, 0x75, 0xE7, 0x3C, 0x52,
-	0x89, 0xEF, 0x34, 0x62, 0xB9, 0x4F, 0x97, 0xA1,
-	0x71, 0xC7, 0x24, 0x92, 0xDB, 0x6E, 0xDB, 0x66,
-	0xDB, 0x56, 0xDB, 0xF6, 0xD8, 0x36, 0xD0, 0xB6,
-	0xE3, 0xB6, 0x49, 0xB5, 0xB5, 0xBD, 0xBD, 0x8D,
-	0x8D, 0x2D, 0x2E, 0xEE, 0xE6, 0x66, 0x55, 0x54
-};
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * Block mixer: sums the four channel buffers into interleaved stereo, each
+ * channel weighted by its gain on that side.
+ *
+ * The gains fold in NR51 (channel on/off per side), NR50 (master volume
+ * per side), the NR52 power bit and the channel mask, 256 being full
+ * volume. With four channels of at most +-15 the sum always fits in 16
+ * bits. Channels whose gains are both 0 are left out of the list the
+ * kernels loop over, so a muted channel costs nothing to mix.
+ *
+ * mix_scalar is the reference. On a PC there are SSE2 and AVX2 kernels
+ * (AVX2 picked at runtime if the CPU has it), and NEON on ARM. They all
+ * give the same output, and mix_select can force one to check that.
+ */
+
+#pragma once
+
+#include <string.h>
+#if defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+struct mix_gain_s
+{
+    int16_t gain[2][4];     /* [side][channel], side 0 is out[0] */
+    uint8_t count;          /* Channels with a gain on either side */
+    uint8_t channel[4];     /* Which ones */
+};
+
+typedef void (*mix_kernel_t)(int16_t *out, const int16_t *const ch[4], const struct mix_gain_s *g, uint32_t frames);
+
+
+/**
+ * Rebuilds the list of channels to mix, after the gains have changed.
+ */
+void mix_gain_update(struct mix_gain_s *g){
+    g->count = 0;
+    for(int c = 0; c < 4; c++){
+        if(g->gain[0][c] || g->gain[1][c]) g->channel[g->count++] = c;
+    }
+}
+
+
+void mix_scalar(int16_t *out, const int16_t *const ch[4], const struct mix_gain_s *g, uint32_t frames){
+    for(uint32_t i = 0; i < frames; i++){
+        int16_t l = 0, r = 0;
+        for(int k = 0; k < g->count; k++){
+            int c = g->channel[k];
+            l += ch[c][i] * g->gain[0][c];
+            r += ch[c][i] * g->gain[1][c];
+        }
+        out[i * 2] = l;
+        out[i * 2 + 1] = r;
+    }
+}
+
+#if defined(__SSE2__)
+void mix_sse2(int16_t *out, const int16_t *const ch[4], const struct mix_gain_s *g, uint32_t frames){
+    __m128i gl[4], gr[4];
+    uint32_t i = 0;
+
+    for(int k = 0; k < g->count; k++){
+        gl[k] = _mm_set1_epi16(g->gain[0][g->channel[k]]);
+        gr[k] = _mm_set1_epi16(g->gain[1][g->channel[k]]);
+    }
+    for(; i + 8 <= frames; i += 8){
+        __m128i l = _mm_setzero_si128(), r = _mm_setzero_si128();
+        for(int k = 0; k < g->count; k++){
+            __m128i x = _mm_loadu_si128((const __m128i *)&ch[g->channel[k]][i]);
+            l = _mm_add_epi16(l, _mm_mullo_epi16(x, gl[k]));
+            r = _mm_add_epi16(r, _mm_mullo_epi16(x, gr[k]));
+        }
+        _mm_storeu_si128((__m128i *)&out[i * 2], _mm_unpacklo_epi16(l, r));
+        _mm_storeu_si128((__m128i *)&out[i * 2 + 8], _mm_unpackhi_epi16(l, r));
+    }
+    if(i < frames){
+        const int16_t *const rest[4] = {&ch[0][i], &ch[1][i], &ch[2][i], &ch[3][i]};
+        mix_scalar(&out[i * 2], rest, g, frames - i);
+    }
+}
+
+__attribute__((target("avx2")))
+void mix_avx2(int16_t *out, const int16_t *const ch[4], const struct mix_gain_s *g, uint32_t frames){
+    __m256i gl[4], gr[4];
+    uint32_t i = 0;
+
+    for(int k = 0; k < g->count; k++){
+        gl[k] = _mm256_set1_epi16(g->gain[0][g->channel[k]]);
+        gr[k] = _mm256_set1_epi16(g->gain[1][g->channel[k]]);
+    }
+    for(; i + 16 <= frames; i += 16){
+        __m256i l = _mm256_setzero_si256(), r = _mm256_setzero_si256();
+        for(int k = 0; k < g->count; k++){
+            __m256i x = _mm256_loadu_si256((const __m256i *)&ch[g->channel[k]][i]);
+            l = _mm256_add_epi16(l, _mm256_mullo_epi16(x, gl[k]));
+            r = _mm256_add_epi16(r, _mm256_mullo_epi16(x, gr[k]));
+        }
+        // unpack works within 128 bit lanes, so the halves need putting back in order
+        __m256i lo = _mm256_unpacklo_epi16(l, r), hi = _mm256_unpackhi_epi16(l, r);
+        _mm256_storeu_si256((__m256i *)&out[i * 2], _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)&out[i * 2 + 16], _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    if(i < frames){
+        const int16_t *const rest[4] = {&ch[0][i], &ch[1][i], &ch[2][i], &ch[3][i]};
+        mix_sse2(&out[i * 2], rest, g, frames - i);
+    }
+}
+#endif
+
+#if defined(__ARM_NEON)
+void mix_neon(int16_t *out, const int16_t *const ch[4], const struct mix_gain_s *g, uint32_t frames){
+    uint32_t i = 0;
+
+    for(; i + 8 <= frames; i += 8){
+        int16x8x2_t lr;
+        lr.val[0] = vdupq_n_s16(0);
+        lr.val[1] = vdupq_n_s16(0);
+        for(int k = 0; k < g->count; k++){
+            int c = g->channel[k];
+            int16x8_t x = vld1q_s16(&ch[c][i]);
+            lr.val[0] = vmlaq_n_s16(lr.val[0], x, g->gain[0][c]);
+            lr.val[1] = vmlaq_n_s16(lr.val[1], x, g->gain[1][c]);
+        }
+        vst2q_s16(&out[i * 2], lr);
+    }
+    if(i < frames){
+        const int16_t *const rest[4] = {&ch[0][i], &ch[1][i], &ch[2][i], &ch[3][i]};
+        mix_scalar(&out[i * 2], rest, g, frames - i);
+    }
+}
+#endif
+
+
+/**
+ * Turns a sum of mixes (see apu_mix) into 8 bit output, clipping it.
+ */
+void mix_to_s8(const int32_t *acc, int8_t *out, uint32_t samples){
+    for(uint32_t i = 0; i < samples; i++){
+        int32_t x = acc[i] >> 8;
+        out[i] = x > 127 ? 127 : (x < -128 ? -128 : x);
+    }
+}
+
+
+/* The kernel in use */
+mix_kernel_t mix_kernel = mix_scalar;
+
+/**
+ * Picks a mix kernel by name ("scalar", "sse2", "avx2", "neon"), or the
+ * fastest one this CPU runs if name is NULL. Returns the name of the kernel
+ * picked, or NULL if the one asked for is not available.
+ */
+const char *mix_select(const char *name){
+    static const struct { const char *name; mix_kernel_t kernel; } kernels[] = {
+#if defined(__SSE2__)
+        {"avx2", mix_avx2},
+        {"sse2", mix_sse2},
+#endif
+#if defined(__ARM_NEON)
+        {"neon", mix_neon},
+#endif
+        {"scalar", mix_scalar},
+    };
+
+    for(uint32_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++){
+        if(name && strcmp(name, kernels[k].name)) continue;
+#if defined(__SSE2__)
+        if(kernels[k].kernel == mix_avx2 && !__builtin_cpu_supports("avx2")){
+            if(name) return NULL;
+            continue;
+        }
+#endif
+        mix_kernel = kernels[k].kernel;
+        return kernels[k].name;
+    }
+    return NULL;
+}
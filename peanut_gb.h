@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <stdlib.h>
+
 /* Interrupt masks */
 #define VBLANK_INTR    0x01
 #define LCDC_INTR    0x02
@@ -40,13 +42,15 @@
 #define ANY_INTR    0x1F
 
 /* Memory section sizes for DMG */
-#define SRAM_SIZE    0x8000
+#define SRAM_BANK_SIZE  0x2000
+#define SRAM_BANKS      4
 #define WRAM_SIZE    0x2000
 #define HRAM_SIZE    0x0100
 
 /* Memory addresses */
 #define ROM_0_ADDR      0x0000
 #define ROM_N_ADDR      0x4000
+#define VRAM_ADDR       0x8000
 #define CART_RAM_ADDR   0xA000
 #define WRAM_0_ADDR     0xC000
 #define ECHO_ADDR       0xE000
@@ -128,34 +132,61 @@
 
 #define ROM_HEADER_CHECKSUM_LOC    0x014D
 
+/* Decoded ROM instructions kept per context (a power of 2), 0 to always
+ * decode from memory. */
+#ifndef GB_DECODE_ENTRIES
+    #define GB_DECODE_ENTRIES   512
+#endif
+#define GB_DECODE_EMPTY     0xFFFFFFFF
+
+/* Translated blocks kept per context (a power of 2), 0 to step through
+ * every instruction. The profiling build counts single steps, so it always
+ * does that. */
+#ifndef GB_BLOCK_ENTRIES
+    #define GB_BLOCK_ENTRIES    128
+#endif
+#ifdef GB_PROFILE
+    #undef GB_BLOCK_ENTRIES
+    #define GB_BLOCK_ENTRIES    0
+#endif
+#define GB_BLOCK_OPS        8  /* Most instructions in one block */
+
+/* Blocks compiled ahead of time by gbs_aot: GB_AOT names the header it
+ * wrote. They run in place of translated ones, so need those. */
+#if defined(GB_AOT) && !GB_BLOCK_ENTRIES
+    #undef GB_AOT
+#endif
+
+/* Write watchpoints for host tools, see gb_watch_add. Without GB_WATCH
+ * defined there is no trace of them; with it, only writes to the 256 byte
+ * pages with a watch in them look any further. */
+#ifdef GB_WATCH
+    #define GB_WATCHES          8  /* Most watches set at once */
+#endif
+
+/* Superinstructions, numbered with opcodes the SM83 does not have. */
+#define GB_OP_LDI_LDH       0xD3    /* LD A, (HL+) then LDH (imm), A */
+#define GB_OP_DEC_B_JRNZ    0xDB    /* DEC B then JR NZ, imm */
+#define GB_OP_DEC_C_JRNZ    0xDD    /* DEC C then JR NZ, imm */
+#define GB_OP_INC_BC        0xE3    /* INC C, JR NZ over the next, INC B */
+#define GB_OP_INC_DE        0xE4    /* INC E, JR NZ over the next, INC D */
+#define GB_OP_INC_HL        0xEB    /* INC L, JR NZ over the next, INC H */
+
 #ifndef MIN
     #define MIN(a, b)   ((a) < (b) ? (a) : (b))
 #endif
 
 struct cpu_registers_s
 {
-    /* Combine A and F registers. */
-    union
-    {
-        struct
-        {
-            /* Define specific bits of Flag register. */
-            union
-            {
-                struct
-                {
-                    uint8_t unused : 4;
-                    uint8_t c : 1; /* Carry flag. */
-                    uint8_t h : 1; /* Half carry flag. */
-                    uint8_t n : 1; /* Add/sub flag. */
-                    uint8_t z : 1; /* Zero flag. */
-                } f_bits;
-                uint8_t f;
-            };
-            uint8_t a;
-        };
-        uint16_t af;
-    };
+    uint8_t a;
+
+    /* The flags are kept as the values they come from, and only worked out
+     * when read: Z is set if f_z is 0, H is bit 4 of f_h, C is bit 0 of
+     * f_c, and N is f_n. __gb_get_f() puts them together into F. */
+    uint8_t f_z;
+    uint8_t f_n;
+    uint8_t f_h;
+    uint8_t f_c;
 
     union
     {
@@ -203,6 +234,34 @@ struct count_s
   int8_t apu_wav_count; /* Count which wav sample is set to be mixed. */
 };
 
+#ifdef GB_PROFILE
+/* Execution counts for the profiling build, kept across songs. */
+struct gb_profile_s
+{
+    uint64_t op_count[0x100];
+    uint64_t op_cycles[0x100];
+    uint64_t cb_count[0x100];
+    uint64_t cb_cycles[0x100];
+    uint64_t halt_cycles;
+    uint64_t reads[0x100];  /* Per 256 byte page, including opcode fetches */
+    uint64_t writes[0x100];
+};
+#endif
+
+#ifdef GB_WATCH
+struct gb_s;
+/* Called with the byte at addr still as it was, before val is written. */
+typedef void (*gb_watch_fn)(struct gb_s *gb, uint16_t addr, uint8_t val, void *user);
+
+struct gb_watch_s
+{
+    uint16_t addr;
+    uint16_t size;      /* Bytes from addr */
+    gb_watch_fn fn;
+    void *user;
+};
+#endif
+
 struct gb_registers_s
 {
     /* TODO: Sort variables in address order. */
@@ -219,26 +278,11 @@ struct gb_registers_s
         uint8_t TAC;
     };
 
-    /* LCD */
+    /* LCD, only what VBlank and STAT interrupt timing needs. */
     uint8_t LCDC;
     uint8_t STAT;
-    uint8_t SCY;
-    uint8_t SCX;
     uint8_t LY;
     uint8_t LYC;
-    uint8_t DMA;
-    uint8_t BGP;
-    uint8_t OBP0;
-    uint8_t OBP1;
-    uint8_t WY;
-    uint8_t WX;
-
-    /* Joypad info. */
-    uint8_t P1;
-
-    /* Serial data. */
-    uint8_t SB;
-    uint8_t SC;
 
     /* Interrupt flag. */
     uint8_t IF;
@@ -247,6 +291,69 @@ struct gb_registers_s
     uint8_t IE;
 };
 
+/* One instruction as fetched from ROM. */
+struct gb_decoded_s
+{
+    uint32_t tag;       /* Address, with the ROM bank above bit 16 if in 0x4000-0x7FFF */
+    uint8_t opcode;
+    uint8_t length;     /* Bytes, including the opcode */
+    uint16_t imm;       /* Operand, little endian */
+};
+
+/* One instruction, or superinstruction, of a translated block. */
+struct gb_block_op_s
+{
+    uint8_t opcode;
+    uint8_t length;     /* Bytes to move PC on by */
+    uint16_t imm;
+};
+
+#ifdef GB_AOT
+struct gb_s;
+/* A compiled block: runs it, and the ones it leads to, like __gb_run_block.
+ * Returns true if the run has ended. */
+typedef bool (*gb_aot_block_t)(struct gb_s *gb, uint32_t *instructions);
+#endif
+
+/* Straight-line code from one address, up to the branch that ends it. */
+struct gb_block_s
+{
+    uint32_t tag;       /* As in gb_decoded_s */
+    uint8_t count;      /* Ops, 0 if the first instruction cannot be translated */
+    uint8_t idle;       /* Cycles per pass if it is an idle loop, else 0 */
+    struct gb_block_op_s op[GB_BLOCK_OPS];
+#ifdef GB_AOT
+    gb_aot_block_t aot; /* Compiled code for the same address, or NULL */
+#endif
+};
+
+/* Instruction lengths in bytes, by opcode. */
+static const uint8_t GB_OP_LENGTH[0x100] =
+{
+    /* *INDENT-OFF* */
+    /*0 1 2 3 4 5 6 7 8 9 A B C D E F    */
+    1,3,1,1,1,1,2,1,3,1,1,1,1,1,2,1,    /* 0x00 */
+    1,3,1,1,1,1,2,1,2,1,1,1,1,1,2,1,    /* 0x10 */
+    2,3,1,1,1,1,2,1,2,1,1,1,1,1,2,1,    /* 0x20 */
+    2,3,1,1,1,1,2,1,2,1,1,1,1,1,2,1,    /* 0x30 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x40 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x50 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x60 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x70 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x80 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0x90 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0xA0 */
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,    /* 0xB0 */
+    1,1,3,3,3,1,2,1,1,1,3,2,3,3,2,1,    /* 0xC0 */
+    1,1,3,1,3,1,2,1,1,1,3,1,3,1,2,1,    /* 0xD0 */
+    2,1,1,1,1,1,2,1,2,1,3,1,1,1,2,1,    /* 0xE0 */
+    2,1,1,1,1,1,2,1,2,1,3,1,1,1,2,1     /* 0xF0 */
+    /* *INDENT-ON* */
+};
+
+/* Cycles per TIMA increment, by TAC input clock. */
+static const uint_fast16_t TAC_CYCLES[4] = {1024, 16, 64, 256};
+
 enum  LCD{
   LCD_HBLANK = 0,
   LCD_VBLANK = 1,
@@ -259,6 +366,13 @@ enum  LCD{
  *
  * Only values within the `direct` struct may be modified directly by the
  * front-end implementation. Other variables must not be modified.
+ *
+ * Kept small so that several instances fit on the Pico: the GBS data is
+ * used in place (it must outlive the context), cartridge RAM banks are only
+ * allocated once written to, and only the LCD registers that drive the
+ * VBlank timing are kept. The instruction and block caches are the
+ * biggest part (8 bytes per GB_DECODE_ENTRIES, 40 per GB_BLOCK_ENTRIES).
+ * The context must be zeroed before its first gb_load_gbs().
  */
 struct gb_s
 {
@@ -266,26 +380,46 @@ struct gb_s
   {
     unsigned int  gb_halt : 1;
     unsigned int  gb_ime : 1;
-    unsigned int  gb_frame : 1; /* New frame drawn. */
     enum LCD lcd_mode : 2;
+    unsigned int  frame_open : 1;   /* gb_run_frame stopped partway through it for room in the queue */
   };
 
-    uint8_t instance;
     uint8_t selected_rom_bank;
     /* WRAM and VRAM bank selection not available. */
     uint8_t cart_ram_bank;
-    uint16_t cart_ram_bank_offset; //offset to subtract from the address to point to the right SRAM bank
     uint8_t enable_cart_ram;
-    /* Cartridge ROM/RAM mode select. */
-    uint8_t cart_mode_select;
     struct cpu_registers_s cpu_reg;
     struct gb_registers_s gb_reg;
+    uint8_t intr_pending;   /* IF & IE & ANY_INTR, kept up to date as either changes */
+    uint8_t intr_due;       /* Something since the last check may let an interrupt be taken */
     struct count_s counter;
-
-    uint8_t rom[0x20000];
-    uint8_t sram[SRAM_SIZE];
+    int_fast32_t frame_cycles;      /* Left to run in this frame, less than 0 if it ran over */
+    uint32_t frame_length;          /* T-cycles from the start of this frame to the next */
+    struct clock_s frame_clock;     /* Frames to T-cycles */
+    uint32_t frame_ticks;           /* Stats for the open frame so far */
+    uint32_t frame_instructions;
+
+    const uint8_t *rom;     /* GBS data after the header, mapped from load_address */
+    uint32_t rom_size;
+    uint8_t *sram[SRAM_BANKS];  /* NULL until written */
     uint8_t wram[WRAM_SIZE];
     uint8_t hram[HRAM_SIZE];
+#if GB_DECODE_ENTRIES
+    struct gb_decoded_s decoded[GB_DECODE_ENTRIES];  /* Direct mapped by address */
+#endif
+#if GB_BLOCK_ENTRIES
+    struct gb_block_s block[GB_BLOCK_ENTRIES];  /* Direct mapped by a hash of the start address */
+    uint_fast16_t block_cycles;     /* Run in the current block, not yet ticked */
+    uint_fast16_t block_budget;     /* Cycles that can pass before the next timer or LCD event, 0 to end the run */
+#endif
+#ifdef GB_AOT
+    bool aot;   /* The GBS loaded is the one GB_AOT was compiled from */
+#endif
+#ifdef GB_WATCH
+    struct gb_watch_s watch[GB_WATCHES];
+    uint8_t watch_count;
+    uint8_t watch_pages[0x100 / 8];  /* Bit per 256 byte page with a watch in it */
+#endif
 
     uint16_t load_address;
     uint16_t init_address;
@@ -294,72 +428,89 @@ struct gb_s
     uint8_t timer_modulo;
     uint8_t timer_control;
 
-    /* Audio */
-    struct{
-    uint16_t ch1Freq;
-    uint8_t ch1SweepCounter;
-    uint8_t ch1SweepCounterI;
-    bool ch1SweepDir;
-    uint8_t ch1SweepShift;
-    uint8_t ch1Vol;
-    uint8_t ch2Vol;
-    uint8_t ch3Vol;
-    uint8_t ch4Vol;
-    uint8_t ch1VolI;
-    uint8_t ch2VolI;
-    uint8_t ch3VolI;
-    uint8_t ch4VolI;
-    uint8_t ch1Len;
-    uint8_t ch2Len;
-    uint8_t ch3Len;
-    uint8_t ch4Len;
-    uint8_t ch1LenI;
-    uint8_t ch2LenI;
-    uint8_t ch3LenI;
-    uint8_t ch4LenI;
-    bool ch1LenOn;
-    bool ch2LenOn;
-    bool ch3LenOn;
-    bool ch4LenOn;
-    uint8_t ch1EnvCounter;
-    uint8_t ch2EnvCounter;
-    uint8_t ch4EnvCounter;
-    uint8_t ch1EnvCounterI;
-    uint8_t ch2EnvCounterI;
-    uint8_t ch4EnvCounterI;
-    bool ch1EnvDir;
-    bool ch2EnvDir;
-    bool ch4EnvDir;
-    bool ch1DAC;
-    bool ch2DAC;
-    bool ch4DAC;
-    uint16_t WAVRAM[32];
-    uint32_t idleTimer;
-    } audio;
+    /* Sound register writes go to the mixer through this queue. */
+    struct reg_queue_s *apu_queue;
+    struct stats_s *stats;
+    uint32_t song_seq;  /* Last song request served */
+    uint8_t song_count;
+    uint8_t first_song;
+
+#ifdef GB_PROFILE
+    struct gb_profile_s profile;
+#endif
 };
 
 
+/**
+ * Internal function used to read the GBS data. Anything outside of it,
+ * including the space below load_address, reads as 0.
+ */
+uint8_t __gb_read_rom(struct gb_s *gb, uint32_t addr){
+    addr -= gb->load_address;
+    return addr < gb->rom_size ? gb->rom[addr] : 0x00;
+}
+
+#if GB_BLOCK_ENTRIES
+/**
+ * Internal function used to bring the timers and LCD up to date within a
+ * block, before an I/O register is touched. The cycles so far are short of
+ * the budget, so nothing but the counters moves.
+ */
+static inline void __gb_block_sync(struct gb_s *gb){
+    if(!gb->block_cycles)
+        return;
+
+    gb->frame_cycles -= gb->block_cycles;
+    gb->counter.div_count += gb->block_cycles;
+    if(gb->gb_reg.tac_enable)
+        gb->counter.tima_count += gb->block_cycles;
+    if(gb->gb_reg.LCDC & LCDC_ENABLE)
+        gb->counter.lcd_count += gb->block_cycles;
+    gb->block_budget -= gb->block_cycles;
+    gb->block_cycles = 0;
+}
+#endif
+
+/**
+ * Internal function used to tell when in the frame the instruction running
+ * started, in M-cycles, for the sound register writes it makes.
+ */
+static inline uint16_t __gb_frame_time(const struct gb_s *gb){
+    int_fast32_t left = gb->frame_cycles;
+
+#if GB_BLOCK_ENTRIES
+    /* Run in the block but not ticked yet. */
+    left -= gb->block_cycles;
+#endif
+    return ((int_fast32_t)gb->frame_length - left) / 4;
+}
+
 /**
  * Internal function used to read bytes.
  */
 uint8_t __gb_read(struct gb_s *gb, const uint_fast16_t addr){
+#ifdef GB_PROFILE
+    gb->profile.reads[addr >> 8]++;
+#endif
     switch(addr >> 12){
     case 0x0:
     case 0x1:
     case 0x2:
     case 0x3:
-    	return gb->rom[addr];
+    	return __gb_read_rom(gb, addr);
 	case 0x4:
 	case 0x5:
 	case 0x6:
 	case 0x7:
-    	return gb->rom[addr + ((gb->selected_rom_bank - 1) << 14)];
+    	return __gb_read_rom(gb, addr + ((gb->selected_rom_bank - 1) << 14));
     case 0x8:
     case 0x9:
         return 0;
     case 0xA:
     case 0xB:
-        return gb->sram[addr - gb->cart_ram_bank_offset];
+        if(gb->sram[gb->cart_ram_bank])
+            return gb->sram[gb->cart_ram_bank][addr - CART_RAM_ADDR];
+        return 0x00;
 
     case 0xC:
     case 0xD:
@@ -384,17 +535,22 @@ uint8_t __gb_read(struct gb_s *gb, const uint_fast16_t addr){
             return gb->hram[addr - IO_ADDR] & APU_READ_MASK[addr - IO_ADDR];
         }
 
+#if GB_BLOCK_ENTRIES
+        __gb_block_sync(gb);
+#endif
+
         /* IO and Interrupts. */
         switch(addr & 0xFF){
         /* IO Registers */
+        /* Joypad and serial are not emulated. */
         case 0x00:
-            return 0xC0 | gb->gb_reg.P1;
+            return 0xC0;
 
         case 0x01:
-            return gb->gb_reg.SB;
+            return 0x00;
 
         case 0x02:
-            return gb->gb_reg.SC;
+            return 0x7E;
 
         /* Timer Registers */
         case 0x04:
@@ -421,38 +577,22 @@ uint8_t __gb_read(struct gb_s *gb, const uint_fast16_t addr){
             return (gb->gb_reg.STAT & STAT_USER_BITS) |
                    (gb->gb_reg.LCDC & LCDC_ENABLE ? gb->lcd_mode : LCD_VBLANK);
 
-        case 0x42:
-            return gb->gb_reg.SCY;
-
-        case 0x43:
-            return gb->gb_reg.SCX;
-
         case 0x44:
             return gb->gb_reg.LY;
 
         case 0x45:
             return gb->gb_reg.LYC;
 
-        /* DMA Register */
+        /* Scroll, DMA, palette and window registers are not kept. */
+        case 0x42:
+        case 0x43:
         case 0x46:
-            return gb->gb_reg.DMA;
-
-        /* DMG Palette Registers */
         case 0x47:
-            return gb->gb_reg.BGP;
-
         case 0x48:
-            return gb->gb_reg.OBP0;
-
         case 0x49:
-            return gb->gb_reg.OBP1;
-
-        /* Window Position Registers */
         case 0x4A:
-            return gb->gb_reg.WY;
-
-    case 0x4B:
-      return gb->gb_reg.WX;
+        case 0x4B:
+            return 0x00;
 
         /* Interrupt Enable Register */
         case 0xFF:
@@ -466,10 +606,61 @@ uint8_t __gb_read(struct gb_s *gb, const uint_fast16_t addr){
     return 0xFF;
 }
 
+/**
+ * Internal function used to keep the sound registers readable by the CPU.
+ * The APU itself runs on the consumer side, so length counters running out
+ * are not reflected in NR52 here.
+ */
+void __gb_write_apu_shadow(struct gb_s *gb, const uint8_t reg, const uint8_t val){
+    gb->hram[reg] = (val & APU_WRITE_MASK[reg]) + (gb->hram[reg] & (APU_WRITE_MASK[reg]^0xFF));
+
+    if(val & 0x80){
+        switch(reg){
+        case 0x14:
+            if(gb->hram[0x12] & 0xF8) gb->hram[0x26] |= 0x01;
+            break;
+
+        case 0x19:
+            if(gb->hram[0x17] & 0xF8) gb->hram[0x26] |= 0x02;
+            break;
+
+        case 0x1E:
+            if(gb->hram[0x1A] & 0x80) gb->hram[0x26] |= 0x04;
+            break;
+
+        case 0x23:
+            gb->hram[0x26] |= 0x08;
+            break;
+        }
+    }
+}
+
+#ifdef GB_WATCH
+/**
+ * Internal function used to call the watches on a byte about to be
+ * written, once it is known to be in a watched page.
+ */
+void __gb_watch(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
+    for(uint8_t i = 0; i < gb->watch_count; i++){
+        const struct gb_watch_s *w = &gb->watch[i];
+
+        if((uint16_t)(addr - w->addr) < w->size)
+            w->fn(gb, addr, val, w->user);
+    }
+}
+#endif
+
 /**
  * Internal function used to write bytes.
  */
 void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
+#ifdef GB_PROFILE
+    gb->profile.writes[addr >> 8]++;
+#endif
+#ifdef GB_WATCH
+    if(gb->watch_pages[addr >> 11] & (1 << ((addr >> 8) & 7)))
+        __gb_watch(gb, addr, val);
+#endif
     switch(addr >> 12){
     case 0x0:
     case 0x1:
@@ -483,19 +674,25 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
         if((gb->selected_rom_bank & 0x1F) == 0x00)
             gb->selected_rom_bank++;
         gb->selected_rom_bank = gb->selected_rom_bank;
+#if GB_BLOCK_ENTRIES
+        /* The block running may have been translated from the old bank. */
+        gb->block_budget = 0;
+#endif
         return;
 
     case 0x4:
     case 0x5:
         gb->cart_ram_bank = (val & 3);
-        gb->cart_ram_bank_offset = 0xA000 - (gb->cart_ram_bank << 13);
         gb->selected_rom_bank = ((val & 3) << 5) | (gb->selected_rom_bank & 0x1F);
         gb->selected_rom_bank = gb->selected_rom_bank;
+#if GB_BLOCK_ENTRIES
+        gb->block_budget = 0;
+#endif
         return;
 
     case 0x6:
     case 0x7:
-        gb->cart_mode_select = (val & 1);
+        /* ROM/RAM mode select makes no difference here. */
         return;
 
     case 0x8:
@@ -504,7 +701,13 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
 
     case 0xA:
     case 0xB:
-        if(gb->enable_cart_ram) gb->sram[addr - gb->cart_ram_bank_offset] = val;
+        if(!gb->enable_cart_ram)
+            return;
+
+        if(!gb->sram[gb->cart_ram_bank])
+            gb->sram[gb->cart_ram_bank] = calloc(1, SRAM_BANK_SIZE);
+        if(gb->sram[gb->cart_ram_bank])
+            gb->sram[gb->cart_ram_bank][addr - CART_RAM_ADDR] = val;
 
         return;
 
@@ -532,152 +735,17 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
             return;
         }
 
-        if((addr >= 0xFF10) && (addr <= 0xFF2F)){
-            if(gb->hram[addr - IO_ADDR] != val) gb->audio.idleTimer = 0;
-            switch(addr & 0xFF){
-
-                case 0x10://ch1 sweep
-                    gb->hram[addr - IO_ADDR] = val;
-                    gb->audio.ch1SweepDir = (val & 0x08) >> 3;
-                    gb->audio.ch1SweepCounter = gb->audio.ch1SweepCounterI = (val & 0x70) >> 4;
-                    gb->audio.ch1SweepShift = (val & 0x07);
-                break;
-
-                case 0x11://ch1 duty/length
-                    gb->hram[addr - IO_ADDR] = val; 
-                    gb->audio.ch1Len = gb->audio.ch1LenI = 64 - (val & 0x3F);
-                break;
-
-                case 0x16://ch2 duty/length
-                    gb->hram[addr - IO_ADDR] = val; 
-                    gb->audio.ch2Len = gb->audio.ch2LenI = 64 - (val & 0x3F);
-                break;
-
-                case 0x1B://ch3 length
-                    gb->hram[addr - IO_ADDR] = val; 
-                    gb->audio.ch3Len = gb->audio.ch3LenI = 256 - val;
-                break;
-
-                case 0x20://ch4 length
-                    gb->hram[addr - IO_ADDR] = val; 
-                    gb->audio.ch4Len = gb->audio.ch4LenI = 64 - (val & 0x3F);
-                break;
-
-                case 0x12://ch1 envelope
-                    gb->hram[addr - IO_ADDR] = val;
-                    gb->audio.ch1DAC = (val & 0xF8) > 0;
-                    gb->audio.ch1Vol = gb->audio.ch1VolI = (val & 0xF0) >> 4;
-                    gb->audio.ch1EnvDir = (val & 0x08) >> 3;
-                    gb->audio.ch1EnvCounter = gb->audio.ch1EnvCounterI = (val & 0x07);
-                break;
-
-                case 0x17://ch2 envelope
-                    gb->hram[addr - IO_ADDR] = val;
-                    gb->audio.ch2DAC = (val & 0xF8) > 0;
-                    gb->audio.ch2Vol = gb->audio.ch2VolI = (val & 0xF0) >> 4;
-                    gb->audio.ch2EnvDir = (val & 0x08) >> 3;
-                    gb->audio.ch2EnvCounter = gb->audio.ch2EnvCounterI = (val & 0x07);
-                break;
-
-                case 0x1C://ch3 Volume (on hardware, this bitshifts the wav samples. The method here is quicker, sounds better, but is less accurate compared to hardware)
-                    gb->hram[addr - IO_ADDR] = val;
-                    switch((val & 0x60)){
-                        case 0x00://mute
-                            gb->audio.ch3Vol = gb->audio.ch3VolI = 8;
-                        break;
-                        case 0x20://full
-                            gb->audio.ch3Vol = gb->audio.ch3VolI = 0;
-                        break;
-                        case 0x40://half
-                            gb->audio.ch3Vol = gb->audio.ch3VolI = 2;
-                        break;
-                        case 0x60://quarter
-                            gb->audio.ch3Vol = gb->audio.ch3VolI = 3;
-                        break;
-                    }
-
-                break;
-
-                case 0x21://ch4 envelope
-                    gb->hram[addr - IO_ADDR] = val;
-                    gb->audio.ch4DAC = (val & 0xF8) > 0;
-                    gb->audio.ch4Vol = gb->audio.ch4VolI = (val & 0xF0) >> 4;
-                    gb->audio.ch4EnvDir = (val & 0x08) >> 3;
-                    gb->audio.ch4EnvCounter = gb->audio.ch4EnvCounterI = (val & 0x07);
-                break;
-
-                case 0x14://ch1 retrigger sound
-                    gb->hram[addr - IO_ADDR] = val;
-                    if(val&0x80){
-                        gb->audio.ch1Vol = gb->audio.ch1VolI;
-                        if(gb->audio.ch1DAC) gb->hram[0x26] |= 0x01;
-                        gb->audio.ch1SweepCounter = gb->audio.ch1SweepCounterI;
-                        gb->audio.ch1EnvCounter = gb->audio.ch1EnvCounterI;
-                        gb->audio.ch1Len = gb->audio.ch1LenI;
-                    }
-                    if(val&0x40){
-                        gb->audio.ch1LenOn = 1;
-                    }else{
-                        gb->audio.ch1LenOn = 0;
-                    }
-                break;
-
-                case 0x19://ch2 retrigger sound
-                    gb->hram[addr - IO_ADDR] = val;
-                    if(val&0x80){
-                        gb->audio.ch2Vol = gb->audio.ch2VolI;
-                        if(gb->audio.ch2DAC) gb->hram[0x26] |= 0x02;
-                        gb->audio.ch2EnvCounter = gb->audio.ch2EnvCounterI;
-                        gb->audio.ch2Len = gb->audio.ch2LenI;
-                    }
-                    if(val&0x40){
-                        gb->audio.ch2LenOn = 1;
-                    }else{
-                        gb->audio.ch2LenOn = 0;
-                    }
-                break;
-
-                case 0x1E://ch3 retrigger sound
-                    gb->hram[addr - IO_ADDR] = val;
-                    if(val&0x80){
-                        gb->audio.ch3Vol = gb->audio.ch3VolI;
-                        if(gb->hram[0x1A] & 0x80) gb->hram[0x26] |= 0x04;
-                        gb->audio.ch3Len = gb->audio.ch3LenI;
-                    }
-                    if(val&0x40){
-                        gb->audio.ch3LenOn = 1;
-                    }else{
-                        gb->audio.ch3LenOn = 0;
-                    }
-                break;
-
-                case 0x23://ch4 retrigger sound
-                    gb->hram[addr - IO_ADDR] = val;
-                    if(val&0x80){
-                        gb->audio.ch4Vol = gb->audio.ch4VolI;
-                        //if(gb->audio.ch4DAC) 
-                        gb->hram[0x26] |= 0x08;
-                        gb->audio.ch4EnvCounter = gb->audio.ch4EnvCounterI;
-                        gb->audio.ch4Len = gb->audio.ch4LenI;
-                    }
-                    if(val&0x40){
-                        gb->audio.ch4LenOn = 1;
-                    }else{
-                        gb->audio.ch4LenOn = 0;
-                    }
-                break;
-
-                default: gb->hram[addr - IO_ADDR] = (val & APU_WRITE_MASK[addr - IO_ADDR]) + (gb->hram[addr - IO_ADDR] & (APU_WRITE_MASK[addr - IO_ADDR]^0xFF)); break;
-                }
+        if((addr >= 0xFF10) && (addr <= 0xFF3F)){
+            reg_queue_push(gb->apu_queue, __gb_frame_time(gb), addr & 0xFF, val);
+            __gb_write_apu_shadow(gb, addr & 0xFF, val);
             return;
         }
 
-        if((addr >= 0xFF30) && (addr <= 0xFF3F)){
-            gb->audio.WAVRAM[((addr & 0x0F) << 1)] = -15 + ((val & 0xF0) >> 3);
-            gb->audio.WAVRAM[((addr & 0x0F) << 1) + 1] = -15 + ((val & 0x0F) << 1);
-        return;
-        }
-
+#if GB_BLOCK_ENTRIES
+        /* Timer, LCD and interrupt writes change what the block budgeted for. */
+        __gb_block_sync(gb);
+        gb->block_budget = 0;
+#endif
 
         /* IO and Interrupts. */
         switch(addr & 0xFF){
@@ -703,6 +771,8 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
         /* Interrupt Flag Register */
         case 0x0F:
             gb->gb_reg.IF = (val | 0b11100000);
+            gb->intr_pending = gb->gb_reg.IF & gb->gb_reg.IE & ANY_INTR;
+            gb->intr_due = 1;
             return;
 
         /* LCD Registers */
@@ -729,14 +799,6 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
             gb->gb_reg.STAT = (val & 0b01111000);
             return;
 
-        case 0x42:
-            gb->gb_reg.SCY = val;
-            return;
-
-        case 0x43:
-            gb->gb_reg.SCX = val;
-            return;
-
         /* LY (0xFF44) is read only. */
         case 0x45:
             gb->gb_reg.LYC = val;
@@ -745,212 +807,262 @@ void __gb_write(struct gb_s *gb, const uint_fast16_t addr, const uint8_t val){
         /* Interrupt Enable Register */
         case 0xFF:
             gb->gb_reg.IE = val;
+            gb->intr_pending = gb->gb_reg.IF & gb->gb_reg.IE & ANY_INTR;
+            gb->intr_due = 1;
             return;
         }
     }
 }
 
 
-uint8_t __gb_execute_cb(struct gb_s *gb){
-  uint8_t inst_cycles;
-    uint8_t cbop = __gb_read(gb, gb->cpu_reg.pc++);
-    uint8_t r = (cbop & 0x7);
-    uint8_t b = (cbop >> 3) & 0x7;
-    uint8_t d = (cbop >> 3) & 0x1;
-    uint8_t val;
-    uint8_t writeback = 1;
-
-  inst_cycles = 8;
-    /* Add an additional 8 cycles to these sets of instructions. */
-    switch(cbop & 0xC7){
-    case 0x06:
-    case 0x86:
-  case 0xC6:
-      inst_cycles += 8;
-  break;
-  case 0x46:
-      inst_cycles += 4;
-  break;
-    }
-
-    switch(r){
-    case 0:
-        val = gb->cpu_reg.b;
-        break;
+/**
+ * Internal function used to put the flags together into the F register.
+ */
+static inline uint8_t __gb_get_f(const struct cpu_registers_s *cpu){
+    return (!cpu->f_z << 7) | (cpu->f_n << 6) |
+        ((cpu->f_h & 0x10) << 1) | ((cpu->f_c & 1) << 4);
+}
 
-    case 1:
-        val = gb->cpu_reg.c;
-        break;
+/**
+ * Internal function used to set the flags from a value for the F register.
+ */
+static inline void __gb_set_f(struct cpu_registers_s *cpu, uint8_t f){
+    cpu->f_z = ~f & 0x80;
+    cpu->f_n = (f >> 6) & 1;
+    cpu->f_h = f >> 1;
+    cpu->f_c = (f >> 4) & 1;
+}
 
-    case 2:
-        val = gb->cpu_reg.d;
-        break;
+/* The rotates and shifts of the CB opcodes. Each sets the flags and
+ * returns the result. */
+static inline uint8_t __gb_cb_rlc(struct cpu_registers_s *cpu, uint8_t val){
+    val = (val << 1) | (val >> 7);
+    cpu->f_z = val;
+    cpu->f_c = val;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-    case 3:
-        val = gb->cpu_reg.e;
-        break;
+static inline uint8_t __gb_cb_rrc(struct cpu_registers_s *cpu, uint8_t val){
+    cpu->f_c = val;
+    val = (val >> 1) | (val << 7);
+    cpu->f_z = val;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-    case 4:
-        val = gb->cpu_reg.h;
-        break;
+static inline uint8_t __gb_cb_rl(struct cpu_registers_s *cpu, uint8_t val){
+    uint8_t carry = val >> 7;
 
-    case 5:
-        val = gb->cpu_reg.l;
-        break;
+    val = (val << 1) | (cpu->f_c & 1);
+    cpu->f_z = val;
+    cpu->f_c = carry;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-    case 6:
-        val = __gb_read(gb, gb->cpu_reg.hl);
-        break;
+static inline uint8_t __gb_cb_rr(struct cpu_registers_s *cpu, uint8_t val){
+    uint8_t carry = val;
 
-    /* Only values 0-7 are possible here, so we make the final case
-     * default to satisfy -Wmaybe-uninitialized warning. */
-    default:
-        val = gb->cpu_reg.a;
-        break;
-    }
+    val = (val >> 1) | ((cpu->f_c & 1) << 7);
+    cpu->f_z = val;
+    cpu->f_c = carry;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-    /* TODO: Find out WTF this is doing. */
-    switch(cbop >> 6){
-    case 0x0:
-        cbop = (cbop >> 4) & 0x3;
+static inline uint8_t __gb_cb_sla(struct cpu_registers_s *cpu, uint8_t val){
+    cpu->f_c = val >> 7;
+    val <<= 1;
+    cpu->f_z = val;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-        switch(cbop){
-        case 0x0: /* RdC R */
-        case 0x1: /* Rd R */
-            if(d) /* RRC R / RR R */
-            {
-                uint8_t temp = val;
-                val = (val >> 1);
-                val |= cbop ? (gb->cpu_reg.f_bits.c << 7) : (temp << 7);
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-                gb->cpu_reg.f_bits.c = (temp & 0x01);
-            }
-            else /* RLC R / RL R */
-            {
-                uint8_t temp = val;
-                val = (val << 1);
-                val |= cbop ? gb->cpu_reg.f_bits.c : (temp >> 7);
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-                gb->cpu_reg.f_bits.c = (temp >> 7);
-            }
+static inline uint8_t __gb_cb_sra(struct cpu_registers_s *cpu, uint8_t val){
+    cpu->f_c = val;
+    val = (val >> 1) | (val & 0x80);
+    cpu->f_z = val;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-            break;
+static inline uint8_t __gb_cb_swap(struct cpu_registers_s *cpu, uint8_t val){
+    val = (val >> 4) | (val << 4);
+    cpu->f_z = val;
+    cpu->f_c = 0;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-        case 0x2:
-            if(d) /* SRA R */
-            {
-                gb->cpu_reg.f_bits.c = val & 0x01;
-                val = (val >> 1) | (val & 0x80);
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-            }
-            else /* SLA R */
-            {
-                gb->cpu_reg.f_bits.c = (val >> 7);
-                val = val << 1;
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-            }
+static inline uint8_t __gb_cb_srl(struct cpu_registers_s *cpu, uint8_t val){
+    cpu->f_c = val;
+    val >>= 1;
+    cpu->f_z = val;
+    cpu->f_n = 0;
+    cpu->f_h = 0;
+    return val;
+}
 
-            break;
+/* Cases for the eight operands of one row of CB opcodes, B C D E H L (HL)
+ * A, each running op on its operand with the code for it written out. */
+#define GB_CB_ROW(base, op, hl_cycles)                                  \
+    case (base) + 0: op(cpu->b); return 8;                              \
+    case (base) + 1: op(cpu->c); return 8;                              \
+    case (base) + 2: op(cpu->d); return 8;                              \
+    case (base) + 3: op(cpu->e); return 8;                              \
+    case (base) + 4: op(cpu->h); return 8;                              \
+    case (base) + 5: op(cpu->l); return 8;                              \
+    case (base) + 6:                                                    \
+    {                                                                   \
+        uint8_t hl = __gb_read(gb, cpu->hl);                            \
+        op(hl);                                                         \
+        if((hl_cycles) == 16)                                           \
+            __gb_write(gb, cpu->hl, hl);                                \
+        return (hl_cycles);                                             \
+    }                                                                   \
+    case (base) + 7: op(cpu->a); return 8;
+
+#define GB_CB_RLC(r)    r = __gb_cb_rlc(cpu, r)
+#define GB_CB_RRC(r)    r = __gb_cb_rrc(cpu, r)
+#define GB_CB_RL(r)     r = __gb_cb_rl(cpu, r)
+#define GB_CB_RR(r)     r = __gb_cb_rr(cpu, r)
+#define GB_CB_SLA(r)    r = __gb_cb_sla(cpu, r)
+#define GB_CB_SRA(r)    r = __gb_cb_sra(cpu, r)
+#define GB_CB_SWAP(r)   r = __gb_cb_swap(cpu, r)
+#define GB_CB_SRL(r)    r = __gb_cb_srl(cpu, r)
+
+/* BIT, RES and SET, for each bit. */
+#define GB_CB_BITS(base, op)                                            \
+    GB_CB_ROW((base) + 0x00, op##_0, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x08, op##_1, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x10, op##_2, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x18, op##_3, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x20, op##_4, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x28, op##_5, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x30, op##_6, op##_HL_CYCLES)                    \
+    GB_CB_ROW((base) + 0x38, op##_7, op##_HL_CYCLES)
+
+#define GB_CB_BIT(r, b)     do{ cpu->f_z = (r) & (1 << (b)); cpu->f_n = 0; cpu->f_h = 0x10; }while(0)
+#define GB_CB_BIT_0(r)      GB_CB_BIT(r, 0)
+#define GB_CB_BIT_1(r)      GB_CB_BIT(r, 1)
+#define GB_CB_BIT_2(r)      GB_CB_BIT(r, 2)
+#define GB_CB_BIT_3(r)      GB_CB_BIT(r, 3)
+#define GB_CB_BIT_4(r)      GB_CB_BIT(r, 4)
+#define GB_CB_BIT_5(r)      GB_CB_BIT(r, 5)
+#define GB_CB_BIT_6(r)      GB_CB_BIT(r, 6)
+#define GB_CB_BIT_7(r)      GB_CB_BIT(r, 7)
+#define GB_CB_BIT_HL_CYCLES 12
+
+#define GB_CB_RES_0(r)      r &= ~0x01
+#define GB_CB_RES_1(r)      r &= ~0x02
+#define GB_CB_RES_2(r)      r &= ~0x04
+#define GB_CB_RES_3(r)      r &= ~0x08
+#define GB_CB_RES_4(r)      r &= ~0x10
+#define GB_CB_RES_5(r)      r &= ~0x20
+#define GB_CB_RES_6(r)      r &= ~0x40
+#define GB_CB_RES_7(r)      r &= ~0x80
+#define GB_CB_RES_HL_CYCLES 16
+
+#define GB_CB_SET_0(r)      r |= 0x01
+#define GB_CB_SET_1(r)      r |= 0x02
+#define GB_CB_SET_2(r)      r |= 0x04
+#define GB_CB_SET_3(r)      r |= 0x08
+#define GB_CB_SET_4(r)      r |= 0x10
+#define GB_CB_SET_5(r)      r |= 0x20
+#define GB_CB_SET_6(r)      r |= 0x40
+#define GB_CB_SET_7(r)      r |= 0x80
+#define GB_CB_SET_HL_CYCLES 16
 
-        case 0x3:
-            if(d) /* SRL R */
-            {
-                gb->cpu_reg.f_bits.c = val & 0x01;
-                val = val >> 1;
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-            }
-            else /* SWAP R */
-            {
-                uint8_t temp = (val >> 4) & 0x0F;
-                temp |= (val << 4) & 0xF0;
-                val = temp;
-                gb->cpu_reg.f_bits.z = (val == 0x00);
-                gb->cpu_reg.f_bits.n = 0;
-                gb->cpu_reg.f_bits.h = 0;
-                gb->cpu_reg.f_bits.c = 0;
-            }
+/**
+ * Internal function used to run a CB prefixed instruction. Every one of the
+ * 256 has its own case, generated by the macros above, so the operand, the
+ * operation and the cycles are all known in it and nothing is decoded at
+ * runtime. Returns the cycles it took.
+ */
+static inline uint8_t __gb_execute_cb(struct gb_s *gb, struct cpu_registers_s *cpu, uint8_t cbop){
+    switch(cbop){
+    GB_CB_ROW(0x00, GB_CB_RLC, 16)
+    GB_CB_ROW(0x08, GB_CB_RRC, 16)
+    GB_CB_ROW(0x10, GB_CB_RL, 16)
+    GB_CB_ROW(0x18, GB_CB_RR, 16)
+    GB_CB_ROW(0x20, GB_CB_SLA, 16)
+    GB_CB_ROW(0x28, GB_CB_SRA, 16)
+    GB_CB_ROW(0x30, GB_CB_SWAP, 16)
+    GB_CB_ROW(0x38, GB_CB_SRL, 16)
+    GB_CB_BITS(0x40, GB_CB_BIT)
+    GB_CB_BITS(0x80, GB_CB_RES)
+    GB_CB_BITS(0xC0, GB_CB_SET)
+    }
+
+    /* Not reached, all 256 are handled above. */
+    return 8;
+}
 
-            break;
+/**
+ * Internal function used to fetch the instruction at PC. Returns its
+ * opcode, puts its operand (if it has one) in imm and moves PC past it.
+ *
+ * GBS code runs from ROM, which never changes, so an instruction there is
+ * only decoded the first time it runs and then served from gb->decoded.
+ * Entries in the switchable bank are tagged with the bank they were read
+ * from, so a bank switch needs no flushing. Code in RAM may be rewritten at
+ * any time and is always read afresh.
+ */
+static inline uint8_t __gb_fetch(struct gb_s *gb, uint16_t *imm){
+    uint16_t pc = gb->cpu_reg.pc;
+    uint8_t opcode, length;
+
+#if GB_DECODE_ENTRIES
+    if(pc < VRAM_ADDR){
+        struct gb_decoded_s *d = &gb->decoded[pc & (GB_DECODE_ENTRIES - 1)];
+        uint32_t tag = pc >= ROM_N_ADDR ? pc | (gb->selected_rom_bank << 16) : pc;
+
+        if(d->tag != tag){
+            d->opcode = __gb_read(gb, pc);
+            d->length = GB_OP_LENGTH[d->opcode];
+            d->imm = d->length > 1 ? __gb_read(gb, pc + 1) : 0;
+            if(d->length > 2) d->imm |= __gb_read(gb, pc + 2) << 8;
+
+            /* One that runs on into the next bank (or out of ROM) is not kept. */
+            d->tag = ((pc ^ (pc + d->length - 1)) & 0xC000) ? GB_DECODE_EMPTY : tag;
         }
-
-        break;
-
-    case 0x1: /* BIT B, R */
-        gb->cpu_reg.f_bits.z = !((val >> b) & 0x1);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        writeback = 0;
-        break;
-
-    case 0x2: /* RES B, R */
-        val &= (0xFE << b) | (0xFF >> (8 - b));
-        break;
-
-    case 0x3: /* SET B, R */
-        val |= (0x1 << b);
-        break;
+#ifdef GB_PROFILE
+        else
+            gb->profile.reads[pc >> 8] += d->length;
+#endif
+        gb->cpu_reg.pc = pc + d->length;
+        *imm = d->imm;
+        return d->opcode;
     }
+#endif
 
-    if(writeback){
-        switch(r){
-        case 0:
-            gb->cpu_reg.b = val;
-            break;
-
-        case 1:
-            gb->cpu_reg.c = val;
-            break;
-
-        case 2:
-            gb->cpu_reg.d = val;
-            break;
-
-        case 3:
-            gb->cpu_reg.e = val;
-            break;
-
-        case 4:
-            gb->cpu_reg.h = val;
-            break;
-
-        case 5:
-            gb->cpu_reg.l = val;
-            break;
-
-        case 6:
-            __gb_write(gb, gb->cpu_reg.hl, val);
-            break;
-
-        case 7:
-            gb->cpu_reg.a = val;
-            break;
-        }
-    }
- return inst_cycles;
+    opcode = __gb_read(gb, pc);
+    length = GB_OP_LENGTH[opcode];
+    *imm = length > 1 ? __gb_read(gb, (uint16_t)(pc + 1)) : 0;
+    if(length > 2) *imm |= __gb_read(gb, (uint16_t)(pc + 2)) << 8;
+    gb->cpu_reg.pc = pc + length;
+    return opcode;
 }
 
 /**
- * Internal function used to step the CPU.
+ * Internal function used to run one instruction once it has been fetched,
+ * with PC already past it, on the registers in cpu. Returns the cycles it
+ * took. The block engine runs on a local copy of the registers, and it is
+ * always inlined there so that they can stay in CPU registers. Compiled
+ * blocks also call it with constant opcodes, for it to fold away.
  */
-void __gb_step_cpu(struct gb_s *gb){
-    if(gb->cpu_reg.pc < 0x0010){  // Hack to help handle GBS
-        gb->cpu_reg.pc = 0;
-        gb->gb_halt = 1;
-        gb->gb_ime = 1;
-        gb->counter.lcd_count = LCD_LINE_CYCLES + 1;
-        gb->gb_reg.LY = LCD_HEIGHT - 1;
-    }
-    uint8_t opcode, inst_cycles;
+#if GB_BLOCK_ENTRIES
+__attribute__((always_inline))
+#endif
+static inline uint8_t __gb_execute(struct gb_s *gb, struct cpu_registers_s *cpu, uint8_t opcode, uint16_t imm){
     static const uint8_t op_cycles[0x100] =
     {
         /* *INDENT-OFF* */
@@ -973,47 +1085,7 @@ void __gb_step_cpu(struct gb_s *gb){
         12,12,8, 4, 0,16, 8,16,12, 8,16, 4, 0, 0, 8,16    /* 0xF0 */
         /* *INDENT-ON* */
     };
-
-    /* Handle interrupts */
-    if((gb->gb_ime || gb->gb_halt) &&
-            (gb->gb_reg.IF & gb->gb_reg.IE & ANY_INTR)){
-        gb->gb_halt = 0;
-
-        if(gb->gb_ime){
-            /* Disable interrupts */
-            gb->gb_ime = 0;
-
-            /* Push Program Counter */
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-
-            /* Call interrupt handler if required. */
-            if(gb->gb_reg.IF & gb->gb_reg.IE & VBLANK_INTR){
-                gb->cpu_reg.pc = gb->play_address;
-                gb->gb_reg.IF ^= VBLANK_INTR;
-            }
-            else if(gb->gb_reg.IF & gb->gb_reg.IE & LCDC_INTR){
-                gb->cpu_reg.pc = gb->play_address;
-                gb->gb_reg.IF ^= LCDC_INTR;
-            }
-            else if(gb->gb_reg.IF & gb->gb_reg.IE & TIMER_INTR){
-                gb->cpu_reg.pc = gb->play_address;
-                gb->gb_reg.IF ^= TIMER_INTR;
-            }
-            else if(gb->gb_reg.IF & gb->gb_reg.IE & SERIAL_INTR){
-                gb->cpu_reg.pc = gb->play_address;
-                gb->gb_reg.IF ^= SERIAL_INTR;
-            }
-            else if(gb->gb_reg.IF & gb->gb_reg.IE & CONTROL_INTR){
-                gb->cpu_reg.pc = gb->play_address;
-                gb->gb_reg.IF ^= CONTROL_INTR;
-            }
-        }
-    }
-
-    /* Obtain opcode */
-    opcode = (gb->gb_halt ? 0x00 : __gb_read(gb, gb->cpu_reg.pc++));
-    inst_cycles = op_cycles[opcode];
+    uint8_t inst_cycles = op_cycles[opcode];
 
     /* Execute opcode */
     switch(opcode){
@@ -1021,96 +1093,93 @@ void __gb_step_cpu(struct gb_s *gb){
         break;
 
     case 0x01: /* LD BC, imm */
-        gb->cpu_reg.c = __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.b = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->bc = imm;
         break;
 
     case 0x02: /* LD (BC), A */
-        __gb_write(gb, gb->cpu_reg.bc, gb->cpu_reg.a);
+        __gb_write(gb, cpu->bc, cpu->a);
         break;
 
     case 0x03: /* INC BC */
-        gb->cpu_reg.bc++;
+        cpu->bc++;
         break;
 
     case 0x04: /* INC B */
-        gb->cpu_reg.b++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.b == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.b & 0x0F) == 0x00);
+        cpu->b++;
+        cpu->f_z = cpu->b;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->b & 0x0F) == 0x00) << 4;
         break;
 
     case 0x05: /* DEC B */
-        gb->cpu_reg.b--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.b == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.b & 0x0F) == 0x0F);
+        cpu->b--;
+        cpu->f_z = cpu->b;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->b & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x06: /* LD B, imm */
-        gb->cpu_reg.b = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->b = imm;
         break;
 
     case 0x07: /* RLCA */
-        gb->cpu_reg.a = (gb->cpu_reg.a << 1) | (gb->cpu_reg.a >> 7);
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = (gb->cpu_reg.a & 0x01);
+        cpu->a = (cpu->a << 1) | (cpu->a >> 7);
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = (cpu->a & 0x01);
         break;
 
     case 0x08: /* LD (imm), SP */
     {
-        uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-        temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-        __gb_write(gb, temp++, gb->cpu_reg.sp & 0xFF);
-        __gb_write(gb, temp, gb->cpu_reg.sp >> 8);
+        uint16_t temp = imm;
+        __gb_write(gb, temp++, cpu->sp & 0xFF);
+        __gb_write(gb, temp, cpu->sp >> 8);
         break;
     }
 
     case 0x09: /* ADD HL, BC */
     {
-        uint_fast32_t temp = gb->cpu_reg.hl + gb->cpu_reg.bc;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (temp ^ gb->cpu_reg.hl ^ gb->cpu_reg.bc) & 0x1000 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFFFF0000) ? 1 : 0;
-        gb->cpu_reg.hl = (temp & 0x0000FFFF);
+        uint_fast32_t temp = cpu->hl + cpu->bc;
+        cpu->f_n = 0;
+        cpu->f_h = (temp ^ cpu->hl ^ cpu->bc) >> 8;
+        cpu->f_c = temp >> 16;
+        cpu->hl = (temp & 0x0000FFFF);
         break;
     }
 
     case 0x0A: /* LD A, (BC) */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.bc);
+        cpu->a = __gb_read(gb, cpu->bc);
         break;
 
     case 0x0B: /* DEC BC */
-        gb->cpu_reg.bc--;
+        cpu->bc--;
         break;
 
     case 0x0C: /* INC C */
-        gb->cpu_reg.c++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.c == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.c & 0x0F) == 0x00);
+        cpu->c++;
+        cpu->f_z = cpu->c;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->c & 0x0F) == 0x00) << 4;
         break;
 
     case 0x0D: /* DEC C */
-        gb->cpu_reg.c--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.c == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.c & 0x0F) == 0x0F);
+        cpu->c--;
+        cpu->f_z = cpu->c;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->c & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x0E: /* LD C, imm */
-        gb->cpu_reg.c = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->c = imm;
         break;
 
     case 0x0F: /* RRCA */
-        gb->cpu_reg.f_bits.c = gb->cpu_reg.a & 0x01;
-        gb->cpu_reg.a = (gb->cpu_reg.a >> 1) | (gb->cpu_reg.a << 7);
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
+        cpu->f_c = cpu->a & 0x01;
+        cpu->a = (cpu->a >> 1) | (cpu->a << 7);
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
         break;
 
     case 0x10: /* STOP */
@@ -1118,582 +1187,570 @@ void __gb_step_cpu(struct gb_s *gb){
         break;
 
     case 0x11: /* LD DE, imm */
-        gb->cpu_reg.e = __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.d = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->de = imm;
         break;
 
     case 0x12: /* LD (DE), A */
-        __gb_write(gb, gb->cpu_reg.de, gb->cpu_reg.a);
+        __gb_write(gb, cpu->de, cpu->a);
         break;
 
     case 0x13: /* INC DE */
-        gb->cpu_reg.de++;
+        cpu->de++;
         break;
 
     case 0x14: /* INC D */
-        gb->cpu_reg.d++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.d == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.d & 0x0F) == 0x00);
+        cpu->d++;
+        cpu->f_z = cpu->d;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->d & 0x0F) == 0x00) << 4;
         break;
 
     case 0x15: /* DEC D */
-        gb->cpu_reg.d--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.d == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.d & 0x0F) == 0x0F);
+        cpu->d--;
+        cpu->f_z = cpu->d;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->d & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x16: /* LD D, imm */
-        gb->cpu_reg.d = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->d = imm;
         break;
 
     case 0x17: /* RLA */
     {
-        uint8_t temp = gb->cpu_reg.a;
-        gb->cpu_reg.a = (gb->cpu_reg.a << 1) | gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = (temp >> 7) & 0x01;
+        uint8_t temp = cpu->a;
+        cpu->a = (cpu->a << 1) | (cpu->f_c & 1);
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = (temp >> 7) & 0x01;
         break;
     }
 
     case 0x18: /* JR imm */
     {
-        int8_t temp = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.pc += temp;
+        int8_t temp = (int8_t) imm;
+        cpu->pc += temp;
         break;
     }
 
     case 0x19: /* ADD HL, DE */
     {
-        uint_fast32_t temp = gb->cpu_reg.hl + gb->cpu_reg.de;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (temp ^ gb->cpu_reg.hl ^ gb->cpu_reg.de) & 0x1000 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFFFF0000) ? 1 : 0;
-        gb->cpu_reg.hl = (temp & 0x0000FFFF);
+        uint_fast32_t temp = cpu->hl + cpu->de;
+        cpu->f_n = 0;
+        cpu->f_h = (temp ^ cpu->hl ^ cpu->de) >> 8;
+        cpu->f_c = temp >> 16;
+        cpu->hl = (temp & 0x0000FFFF);
         break;
     }
 
     case 0x1A: /* LD A, (DE) */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.de);
+        cpu->a = __gb_read(gb, cpu->de);
         break;
 
     case 0x1B: /* DEC DE */
-        gb->cpu_reg.de--;
+        cpu->de--;
         break;
 
     case 0x1C: /* INC E */
-        gb->cpu_reg.e++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.e == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.e & 0x0F) == 0x00);
+        cpu->e++;
+        cpu->f_z = cpu->e;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->e & 0x0F) == 0x00) << 4;
         break;
 
     case 0x1D: /* DEC E */
-        gb->cpu_reg.e--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.e == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.e & 0x0F) == 0x0F);
+        cpu->e--;
+        cpu->f_z = cpu->e;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->e & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x1E: /* LD E, imm */
-        gb->cpu_reg.e = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->e = imm;
         break;
 
     case 0x1F: /* RRA */
     {
-        uint8_t temp = gb->cpu_reg.a;
-        gb->cpu_reg.a = gb->cpu_reg.a >> 1 | (gb->cpu_reg.f_bits.c << 7);
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = temp & 0x1;
+        uint8_t temp = cpu->a;
+        cpu->a = cpu->a >> 1 | ((cpu->f_c & 1) << 7);
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = temp & 0x1;
         break;
     }
 
     case 0x20: /* JP NZ, imm */
-        if(!gb->cpu_reg.f_bits.z){
-            int8_t temp = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-            gb->cpu_reg.pc += temp;
+        if(cpu->f_z){
+            int8_t temp = (int8_t) imm;
+            cpu->pc += temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc++;
 
         break;
 
     case 0x21: /* LD HL, imm */
-        gb->cpu_reg.l = __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.h = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->hl = imm;
         break;
 
     case 0x22: /* LDI (HL), A */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.a);
-        gb->cpu_reg.hl++;
+        __gb_write(gb, cpu->hl, cpu->a);
+        cpu->hl++;
         break;
 
     case 0x23: /* INC HL */
-        gb->cpu_reg.hl++;
+        cpu->hl++;
         break;
 
     case 0x24: /* INC H */
-        gb->cpu_reg.h++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.h == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.h & 0x0F) == 0x00);
+        cpu->h++;
+        cpu->f_z = cpu->h;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->h & 0x0F) == 0x00) << 4;
         break;
 
     case 0x25: /* DEC H */
-        gb->cpu_reg.h--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.h == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.h & 0x0F) == 0x0F);
+        cpu->h--;
+        cpu->f_z = cpu->h;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->h & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x26: /* LD H, imm */
-        gb->cpu_reg.h = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->h = imm;
         break;
 
     case 0x27: /* DAA */
     {
-        uint16_t a = gb->cpu_reg.a;
+        uint16_t a = cpu->a;
 
-        if(gb->cpu_reg.f_bits.n){
-            if(gb->cpu_reg.f_bits.h)
+        if(cpu->f_n){
+            if((cpu->f_h & 0x10))
                 a = (a - 0x06) & 0xFF;
 
-            if(gb->cpu_reg.f_bits.c)
+            if((cpu->f_c & 1))
                 a -= 0x60;
         }
         else
         {
-            if(gb->cpu_reg.f_bits.h || (a & 0x0F) > 9)
+            if((cpu->f_h & 0x10) || (a & 0x0F) > 9)
                 a += 0x06;
 
-            if(gb->cpu_reg.f_bits.c || a > 0x9F)
+            if((cpu->f_c & 1) || a > 0x9F)
                 a += 0x60;
         }
 
         if((a & 0x100) == 0x100)
-            gb->cpu_reg.f_bits.c = 1;
+            cpu->f_c = 1;
 
-        gb->cpu_reg.a = a;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0);
-        gb->cpu_reg.f_bits.h = 0;
+        cpu->a = a;
+        cpu->f_z = cpu->a;
+        cpu->f_h = 0;
 
         break;
     }
 
     case 0x28: /* JP Z, imm */
-        if(gb->cpu_reg.f_bits.z){
-            int8_t temp = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-            gb->cpu_reg.pc += temp;
+        if(!cpu->f_z){
+            int8_t temp = (int8_t) imm;
+            cpu->pc += temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc++;
 
         break;
 
     case 0x29: /* ADD HL, HL */
     {
-        uint_fast32_t temp = gb->cpu_reg.hl + gb->cpu_reg.hl;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = (temp & 0x1000) ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFFFF0000) ? 1 : 0;
-        gb->cpu_reg.hl = (temp & 0x0000FFFF);
+        uint_fast32_t temp = cpu->hl + cpu->hl;
+        cpu->f_n = 0;
+        cpu->f_h = temp >> 8;
+        cpu->f_c = temp >> 16;
+        cpu->hl = (temp & 0x0000FFFF);
         break;
     }
 
     case 0x2A: /* LD A, (HL+) */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.hl++);
+        cpu->a = __gb_read(gb, cpu->hl++);
         break;
 
     case 0x2B: /* DEC HL */
-        gb->cpu_reg.hl--;
+        cpu->hl--;
         break;
 
     case 0x2C: /* INC L */
-        gb->cpu_reg.l++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.l == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.l & 0x0F) == 0x00);
+        cpu->l++;
+        cpu->f_z = cpu->l;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->l & 0x0F) == 0x00) << 4;
         break;
 
     case 0x2D: /* DEC L */
-        gb->cpu_reg.l--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.l == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.l & 0x0F) == 0x0F);
+        cpu->l--;
+        cpu->f_z = cpu->l;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->l & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x2E: /* LD L, imm */
-        gb->cpu_reg.l = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->l = imm;
         break;
 
     case 0x2F: /* CPL */
-        gb->cpu_reg.a = ~gb->cpu_reg.a;
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = 1;
+        cpu->a = ~cpu->a;
+        cpu->f_n = 1;
+        cpu->f_h = 0x10;
         break;
 
     case 0x30: /* JP NC, imm */
-        if(!gb->cpu_reg.f_bits.c){
-            int8_t temp = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-            gb->cpu_reg.pc += temp;
+        if(!(cpu->f_c & 1)){
+            int8_t temp = (int8_t) imm;
+            cpu->pc += temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc++;
 
         break;
 
     case 0x31: /* LD SP, imm */
-        gb->cpu_reg.sp = __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.sp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
+        cpu->sp = imm;
         break;
 
     case 0x32: /* LD (HL), A */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.a);
-        gb->cpu_reg.hl--;
+        __gb_write(gb, cpu->hl, cpu->a);
+        cpu->hl--;
         break;
 
     case 0x33: /* INC SP */
-        gb->cpu_reg.sp++;
+        cpu->sp++;
         break;
 
     case 0x34: /* INC (HL) */
     {
-        uint8_t temp = __gb_read(gb, gb->cpu_reg.hl) + 1;
-        gb->cpu_reg.f_bits.z = (temp == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((temp & 0x0F) == 0x00);
-        __gb_write(gb, gb->cpu_reg.hl, temp);
+        uint8_t temp = __gb_read(gb, cpu->hl) + 1;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = ((temp & 0x0F) == 0x00) << 4;
+        __gb_write(gb, cpu->hl, temp);
         break;
     }
 
     case 0x35: /* DEC (HL) */
     {
-        uint8_t temp = __gb_read(gb, gb->cpu_reg.hl) - 1;
-        gb->cpu_reg.f_bits.z = (temp == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((temp & 0x0F) == 0x0F);
-        __gb_write(gb, gb->cpu_reg.hl, temp);
+        uint8_t temp = __gb_read(gb, cpu->hl) - 1;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = ((temp & 0x0F) == 0x0F) << 4;
+        __gb_write(gb, cpu->hl, temp);
         break;
     }
 
     case 0x36: /* LD (HL), imm */
-        __gb_write(gb, gb->cpu_reg.hl, __gb_read(gb, gb->cpu_reg.pc++));
+        __gb_write(gb, cpu->hl, imm);
         break;
 
     case 0x37: /* SCF */
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 1;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 1;
         break;
 
     case 0x38: /* JP C, imm */
-        if(gb->cpu_reg.f_bits.c){
-            int8_t temp = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-            gb->cpu_reg.pc += temp;
+        if((cpu->f_c & 1)){
+            int8_t temp = (int8_t) imm;
+            cpu->pc += temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc++;
 
         break;
 
     case 0x39: /* ADD HL, SP */
     {
-        uint_fast32_t temp = gb->cpu_reg.hl + gb->cpu_reg.sp;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            ((gb->cpu_reg.hl & 0xFFF) + (gb->cpu_reg.sp & 0xFFF)) & 0x1000 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = temp & 0x10000 ? 1 : 0;
-        gb->cpu_reg.hl = (uint16_t)temp;
+        uint_fast32_t temp = cpu->hl + cpu->sp;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->hl & 0xFFF) + (cpu->sp & 0xFFF)) >> 8;
+        cpu->f_c = temp >> 16;
+        cpu->hl = (uint16_t)temp;
         break;
     }
 
     case 0x3A: /* LD A, (HL--) */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.hl--);
+        cpu->a = __gb_read(gb, cpu->hl--);
         break;
 
     case 0x3B: /* DEC SP */
-        gb->cpu_reg.sp--;
+        cpu->sp--;
         break;
 
     case 0x3C: /* INC A */
-        gb->cpu_reg.a++;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.a & 0x0F) == 0x00);
+        cpu->a++;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->a & 0x0F) == 0x00) << 4;
         break;
 
     case 0x3D: /* DEC A */
-        gb->cpu_reg.a--;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.a & 0x0F) == 0x0F);
+        cpu->a--;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 1;
+        cpu->f_h = ((cpu->a & 0x0F) == 0x0F) << 4;
         break;
 
     case 0x3E: /* LD A, imm */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.pc++);
+        cpu->a = imm;
         break;
 
     case 0x3F: /* CCF */
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = ~gb->cpu_reg.f_bits.c;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = !(cpu->f_c & 1);
         break;
 
     case 0x40: /* LD B, B */
         break;
 
     case 0x41: /* LD B, C */
-        gb->cpu_reg.b = gb->cpu_reg.c;
+        cpu->b = cpu->c;
         break;
 
     case 0x42: /* LD B, D */
-        gb->cpu_reg.b = gb->cpu_reg.d;
+        cpu->b = cpu->d;
         break;
 
     case 0x43: /* LD B, E */
-        gb->cpu_reg.b = gb->cpu_reg.e;
+        cpu->b = cpu->e;
         break;
 
     case 0x44: /* LD B, H */
-        gb->cpu_reg.b = gb->cpu_reg.h;
+        cpu->b = cpu->h;
         break;
 
     case 0x45: /* LD B, L */
-        gb->cpu_reg.b = gb->cpu_reg.l;
+        cpu->b = cpu->l;
         break;
 
     case 0x46: /* LD B, (HL) */
-        gb->cpu_reg.b = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->b = __gb_read(gb, cpu->hl);
         break;
 
     case 0x47: /* LD B, A */
-        gb->cpu_reg.b = gb->cpu_reg.a;
+        cpu->b = cpu->a;
         break;
 
     case 0x48: /* LD C, B */
-        gb->cpu_reg.c = gb->cpu_reg.b;
+        cpu->c = cpu->b;
         break;
 
     case 0x49: /* LD C, C */
         break;
 
     case 0x4A: /* LD C, D */
-        gb->cpu_reg.c = gb->cpu_reg.d;
+        cpu->c = cpu->d;
         break;
 
     case 0x4B: /* LD C, E */
-        gb->cpu_reg.c = gb->cpu_reg.e;
+        cpu->c = cpu->e;
         break;
 
     case 0x4C: /* LD C, H */
-        gb->cpu_reg.c = gb->cpu_reg.h;
+        cpu->c = cpu->h;
         break;
 
     case 0x4D: /* LD C, L */
-        gb->cpu_reg.c = gb->cpu_reg.l;
+        cpu->c = cpu->l;
         break;
 
     case 0x4E: /* LD C, (HL) */
-        gb->cpu_reg.c = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->c = __gb_read(gb, cpu->hl);
         break;
 
     case 0x4F: /* LD C, A */
-        gb->cpu_reg.c = gb->cpu_reg.a;
+        cpu->c = cpu->a;
         break;
 
     case 0x50: /* LD D, B */
-        gb->cpu_reg.d = gb->cpu_reg.b;
+        cpu->d = cpu->b;
         break;
 
     case 0x51: /* LD D, C */
-        gb->cpu_reg.d = gb->cpu_reg.c;
+        cpu->d = cpu->c;
         break;
 
     case 0x52: /* LD D, D */
         break;
 
     case 0x53: /* LD D, E */
-        gb->cpu_reg.d = gb->cpu_reg.e;
+        cpu->d = cpu->e;
         break;
 
     case 0x54: /* LD D, H */
-        gb->cpu_reg.d = gb->cpu_reg.h;
+        cpu->d = cpu->h;
         break;
 
     case 0x55: /* LD D, L */
-        gb->cpu_reg.d = gb->cpu_reg.l;
+        cpu->d = cpu->l;
         break;
 
     case 0x56: /* LD D, (HL) */
-        gb->cpu_reg.d = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->d = __gb_read(gb, cpu->hl);
         break;
 
     case 0x57: /* LD D, A */
-        gb->cpu_reg.d = gb->cpu_reg.a;
+        cpu->d = cpu->a;
         break;
 
     case 0x58: /* LD E, B */
-        gb->cpu_reg.e = gb->cpu_reg.b;
+        cpu->e = cpu->b;
         break;
 
     case 0x59: /* LD E, C */
-        gb->cpu_reg.e = gb->cpu_reg.c;
+        cpu->e = cpu->c;
         break;
 
     case 0x5A: /* LD E, D */
-        gb->cpu_reg.e = gb->cpu_reg.d;
+        cpu->e = cpu->d;
         break;
 
     case 0x5B: /* LD E, E */
         break;
 
     case 0x5C: /* LD E, H */
-        gb->cpu_reg.e = gb->cpu_reg.h;
+        cpu->e = cpu->h;
         break;
 
     case 0x5D: /* LD E, L */
-        gb->cpu_reg.e = gb->cpu_reg.l;
+        cpu->e = cpu->l;
         break;
 
     case 0x5E: /* LD E, (HL) */
-        gb->cpu_reg.e = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->e = __gb_read(gb, cpu->hl);
         break;
 
     case 0x5F: /* LD E, A */
-        gb->cpu_reg.e = gb->cpu_reg.a;
+        cpu->e = cpu->a;
         break;
 
     case 0x60: /* LD H, B */
-        gb->cpu_reg.h = gb->cpu_reg.b;
+        cpu->h = cpu->b;
         break;
 
     case 0x61: /* LD H, C */
-        gb->cpu_reg.h = gb->cpu_reg.c;
+        cpu->h = cpu->c;
         break;
 
     case 0x62: /* LD H, D */
-        gb->cpu_reg.h = gb->cpu_reg.d;
+        cpu->h = cpu->d;
         break;
 
     case 0x63: /* LD H, E */
-        gb->cpu_reg.h = gb->cpu_reg.e;
+        cpu->h = cpu->e;
         break;
 
     case 0x64: /* LD H, H */
         break;
 
     case 0x65: /* LD H, L */
-        gb->cpu_reg.h = gb->cpu_reg.l;
+        cpu->h = cpu->l;
         break;
 
     case 0x66: /* LD H, (HL) */
-        gb->cpu_reg.h = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->h = __gb_read(gb, cpu->hl);
         break;
 
     case 0x67: /* LD H, A */
-        gb->cpu_reg.h = gb->cpu_reg.a;
+        cpu->h = cpu->a;
         break;
 
     case 0x68: /* LD L, B */
-        gb->cpu_reg.l = gb->cpu_reg.b;
+        cpu->l = cpu->b;
         break;
 
     case 0x69: /* LD L, C */
-        gb->cpu_reg.l = gb->cpu_reg.c;
+        cpu->l = cpu->c;
         break;
 
     case 0x6A: /* LD L, D */
-        gb->cpu_reg.l = gb->cpu_reg.d;
+        cpu->l = cpu->d;
         break;
 
     case 0x6B: /* LD L, E */
-        gb->cpu_reg.l = gb->cpu_reg.e;
+        cpu->l = cpu->e;
         break;
 
     case 0x6C: /* LD L, H */
-        gb->cpu_reg.l = gb->cpu_reg.h;
+        cpu->l = cpu->h;
         break;
 
     case 0x6D: /* LD L, L */
         break;
 
     case 0x6E: /* LD L, (HL) */
-        gb->cpu_reg.l = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->l = __gb_read(gb, cpu->hl);
         break;
 
     case 0x6F: /* LD L, A */
-        gb->cpu_reg.l = gb->cpu_reg.a;
+        cpu->l = cpu->a;
         break;
 
     case 0x70: /* LD (HL), B */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.b);
+        __gb_write(gb, cpu->hl, cpu->b);
         break;
 
     case 0x71: /* LD (HL), C */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.c);
+        __gb_write(gb, cpu->hl, cpu->c);
         break;
 
     case 0x72: /* LD (HL), D */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.d);
+        __gb_write(gb, cpu->hl, cpu->d);
         break;
 
     case 0x73: /* LD (HL), E */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.e);
+        __gb_write(gb, cpu->hl, cpu->e);
         break;
 
     case 0x74: /* LD (HL), H */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.h);
+        __gb_write(gb, cpu->hl, cpu->h);
         break;
 
     case 0x75: /* LD (HL), L */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.l);
+        __gb_write(gb, cpu->hl, cpu->l);
         break;
 
     case 0x76: /* HALT */
         /* TODO: Emulate HALT bug? */
         gb->gb_halt = 1;
+        gb->intr_due = 1;
         break;
 
     case 0x77: /* LD (HL), A */
-        __gb_write(gb, gb->cpu_reg.hl, gb->cpu_reg.a);
+        __gb_write(gb, cpu->hl, cpu->a);
         break;
 
     case 0x78: /* LD A, B */
-        gb->cpu_reg.a = gb->cpu_reg.b;
+        cpu->a = cpu->b;
         break;
 
     case 0x79: /* LD A, C */
-        gb->cpu_reg.a = gb->cpu_reg.c;
+        cpu->a = cpu->c;
         break;
 
     case 0x7A: /* LD A, D */
-        gb->cpu_reg.a = gb->cpu_reg.d;
+        cpu->a = cpu->d;
         break;
 
     case 0x7B: /* LD A, E */
-        gb->cpu_reg.a = gb->cpu_reg.e;
+        cpu->a = cpu->e;
         break;
 
     case 0x7C: /* LD A, H */
-        gb->cpu_reg.a = gb->cpu_reg.h;
+        cpu->a = cpu->h;
         break;
 
     case 0x7D: /* LD A, L */
-        gb->cpu_reg.a = gb->cpu_reg.l;
+        cpu->a = cpu->l;
         break;
 
     case 0x7E: /* LD A, (HL) */
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.hl);
+        cpu->a = __gb_read(gb, cpu->hl);
         break;
 
     case 0x7F: /* LD A, A */
@@ -1701,737 +1758,693 @@ void __gb_step_cpu(struct gb_s *gb){
 
     case 0x80: /* ADD A, B */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.b ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->b;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->b ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x81: /* ADD A, C */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.c ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->c;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->c ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x82: /* ADD A, D */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.d ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->d;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->d ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x83: /* ADD A, E */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.e ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->e;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->e ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x84: /* ADD A, H */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.h ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->h;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->h ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x85: /* ADD A, L */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.l ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->l;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->l ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x86: /* ADD A, (HL) */
     {
-        uint8_t hl = __gb_read(gb, gb->cpu_reg.hl);
-        uint16_t temp = gb->cpu_reg.a + hl;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ hl ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint8_t hl = __gb_read(gb, cpu->hl);
+        uint16_t temp = cpu->a + hl;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ hl ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x87: /* ADD A, A */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.a;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = temp & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->a;
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x88: /* ADC A, B */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.b + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.b ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->b + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->b ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x89: /* ADC A, C */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.c + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.c ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->c + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->c ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8A: /* ADC A, D */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.d + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.d ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->d + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->d ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8B: /* ADC A, E */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.e + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.e ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->e + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->e ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8C: /* ADC A, H */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.h + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.h ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->h + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->h ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8D: /* ADC A, L */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.l + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.l ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a + cpu->l + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ cpu->l ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8E: /* ADC A, (HL) */
     {
-        uint8_t val = __gb_read(gb, gb->cpu_reg.hl);
-        uint16_t temp = gb->cpu_reg.a + val + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ val ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint8_t val = __gb_read(gb, cpu->hl);
+        uint16_t temp = cpu->a + val + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
+        cpu->f_h = cpu->a ^ val ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x8F: /* ADC A, A */
     {
-        uint16_t temp = gb->cpu_reg.a + gb->cpu_reg.a + gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
+        uint16_t temp = cpu->a + cpu->a + (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 0;
         /* TODO: Optimisation here? */
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.a ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        cpu->f_h = cpu->a ^ cpu->a ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x90: /* SUB B */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.b ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->b;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->b ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x91: /* SUB C */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.c ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->c;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->c ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x92: /* SUB D */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.d ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->d;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->d ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x93: /* SUB E */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.e ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->e;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->e ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x94: /* SUB H */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.h ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->h;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->h ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x95: /* SUB L */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.l ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->l;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->l ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x96: /* SUB (HL) */
     {
-        uint8_t val = __gb_read(gb, gb->cpu_reg.hl);
-        uint16_t temp = gb->cpu_reg.a - val;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ val ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint8_t val = __gb_read(gb, cpu->hl);
+        uint16_t temp = cpu->a - val;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ val ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x97: /* SUB A */
-        gb->cpu_reg.a = 0;
-        gb->cpu_reg.f_bits.z = 1;
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = 0;
+        cpu->f_z = 0;
+        cpu->f_n = 1;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0x98: /* SBC A, B */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.b - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.b ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->b - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->b ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x99: /* SBC A, C */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.c - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.c ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->c - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->c ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9A: /* SBC A, D */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.d - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.d ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->d - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->d ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9B: /* SBC A, E */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.e - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.e ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->e - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->e ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9C: /* SBC A, H */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.h - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.h ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->h - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->h ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9D: /* SBC A, L */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.l - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.l ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint16_t temp = cpu->a - cpu->l - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->l ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9E: /* SBC A, (HL) */
     {
-        uint8_t val = __gb_read(gb, gb->cpu_reg.hl);
-        uint16_t temp = gb->cpu_reg.a - val - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ val ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint8_t val = __gb_read(gb, cpu->hl);
+        uint16_t temp = cpu->a - val - (cpu->f_c & 1);
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ val ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0x9F: /* SBC A, A */
-        gb->cpu_reg.a = gb->cpu_reg.f_bits.c ? 0xFF : 0x00;
-        gb->cpu_reg.f_bits.z = gb->cpu_reg.f_bits.c ? 0x00 : 0x01;
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = gb->cpu_reg.f_bits.c;
+        cpu->a = (cpu->f_c & 1) ? 0xFF : 0x00;
+        cpu->f_z = cpu->f_c & 1;
+        cpu->f_n = 1;
+        cpu->f_h = (cpu->f_c & 1) << 4;
         break;
 
     case 0xA0: /* AND B */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->b;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA1: /* AND C */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->c;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA2: /* AND D */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->d;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA3: /* AND E */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->e;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA4: /* AND H */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->h;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA5: /* AND L */
-        gb->cpu_reg.a = gb->cpu_reg.a & gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & cpu->l;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA6: /* AND (HL) */
-        gb->cpu_reg.a = gb->cpu_reg.a & __gb_read(gb, gb->cpu_reg.hl);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & __gb_read(gb, cpu->hl);
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA7: /* AND A */
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xA8: /* XOR B */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->b;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xA9: /* XOR C */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->c;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAA: /* XOR D */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->d;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAB: /* XOR E */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->e;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAC: /* XOR H */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->h;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAD: /* XOR L */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ cpu->l;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAE: /* XOR (HL) */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ __gb_read(gb, gb->cpu_reg.hl);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ __gb_read(gb, cpu->hl);
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xAF: /* XOR A */
-        gb->cpu_reg.a = 0x00;
-        gb->cpu_reg.f_bits.z = 1;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = 0x00;
+        cpu->f_z = 0;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB0: /* OR B */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->b;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB1: /* OR C */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->c;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB2: /* OR D */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->d;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB3: /* OR E */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->e;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB4: /* OR H */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->h;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB5: /* OR L */
-        gb->cpu_reg.a = gb->cpu_reg.a | gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | cpu->l;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB6: /* OR (HL) */
-        gb->cpu_reg.a = gb->cpu_reg.a | __gb_read(gb, gb->cpu_reg.hl);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | __gb_read(gb, cpu->hl);
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB7: /* OR A */
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xB8: /* CP B */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.b;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.b ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->b;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->b ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xB9: /* CP C */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.c;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.c ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->c;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->c ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xBA: /* CP D */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.d;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.d ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->d;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->d ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xBB: /* CP E */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.e;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.e ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->e;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->e ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xBC: /* CP H */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.h;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.h ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->h;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->h ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xBD: /* CP L */
     {
-        uint16_t temp = gb->cpu_reg.a - gb->cpu_reg.l;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ gb->cpu_reg.l ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint16_t temp = cpu->a - cpu->l;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ cpu->l ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     /* TODO: Optimsation by combining similar opcode routines. */
     case 0xBE: /* CP (HL) */
     {
-        uint8_t val = __gb_read(gb, gb->cpu_reg.hl);
-        uint16_t temp = gb->cpu_reg.a - val;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ val ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
+        uint8_t val = __gb_read(gb, cpu->hl);
+        uint16_t temp = cpu->a - val;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ val ^ temp;
+        cpu->f_c = temp >> 8;
         break;
     }
 
     case 0xBF: /* CP A */
-        gb->cpu_reg.f_bits.z = 1;
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->f_z = 0;
+        cpu->f_n = 1;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xC0: /* RET NZ */
-        if(!gb->cpu_reg.f_bits.z){
-            gb->cpu_reg.pc = __gb_read(gb, gb->cpu_reg.sp++);
-            gb->cpu_reg.pc |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
+        if(cpu->f_z){
+            cpu->pc = __gb_read(gb, cpu->sp++);
+            cpu->pc |= __gb_read(gb, cpu->sp++) << 8;
             inst_cycles += 12;
         }
 
         break;
 
     case 0xC1: /* POP BC */
-        gb->cpu_reg.c = __gb_read(gb, gb->cpu_reg.sp++);
-        gb->cpu_reg.b = __gb_read(gb, gb->cpu_reg.sp++);
+        cpu->c = __gb_read(gb, cpu->sp++);
+        cpu->b = __gb_read(gb, cpu->sp++);
         break;
 
     case 0xC2: /* JP NZ, imm */
-        if(!gb->cpu_reg.f_bits.z){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            gb->cpu_reg.pc = temp;
+        if(cpu->f_z){
+            uint16_t temp = imm;
+            cpu->pc = temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xC3: /* JP imm */
     {
-        uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-        temp |= __gb_read(gb, gb->cpu_reg.pc) << 8;
-        gb->cpu_reg.pc = temp;
+        uint16_t temp = imm;
+        cpu->pc = temp;
         break;
     }
 
     case 0xC4: /* CALL NZ imm */
-        if(!gb->cpu_reg.f_bits.z){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-            gb->cpu_reg.pc = temp;
+        if(cpu->f_z){
+            uint16_t temp = imm;
+            __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+            __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+            cpu->pc = temp;
             inst_cycles += 12;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xC5: /* PUSH BC */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.b);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.c);
+        __gb_write(gb, --cpu->sp, cpu->b);
+        __gb_write(gb, --cpu->sp, cpu->c);
         break;
 
     case 0xC6: /* ADD A, imm */
     {
         /* Taken from SameBoy, which is released under MIT Licence. */
-        uint8_t value = __gb_read(gb, gb->cpu_reg.pc++);
-        uint16_t calc = gb->cpu_reg.a + value;
-        gb->cpu_reg.f_bits.z = ((uint8_t)calc == 0) ? 1 : 0;
-        gb->cpu_reg.f_bits.h =
-            ((gb->cpu_reg.a & 0xF) + (value & 0xF) > 0x0F) ? 1 : 0;
-        gb->cpu_reg.f_bits.c = calc > 0xFF ? 1 : 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.a = (uint8_t)calc;
+        uint8_t value = imm;
+        uint16_t calc = cpu->a + value;
+        cpu->f_z = calc;
+        cpu->f_h = ((cpu->a & 0xF) + (value & 0xF) > 0x0F) ? 0x10 : 0;
+        cpu->f_c = calc > 0xFF ? 1 : 0;
+        cpu->f_n = 0;
+        cpu->a = (uint8_t)calc;
         break;
     }
 
     case 0xC7: /* RST 0x0000 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0000 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0000 + gb->load_address;
         break;
 
     case 0xC8: /* RET Z */
-        if(gb->cpu_reg.f_bits.z){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.sp++);
-            temp |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
-            gb->cpu_reg.pc = temp;
+        if(!cpu->f_z){
+            uint16_t temp = __gb_read(gb, cpu->sp++);
+            temp |= __gb_read(gb, cpu->sp++) << 8;
+            cpu->pc = temp;
             inst_cycles += 12;
         }
 
@@ -2439,145 +2452,133 @@ void __gb_step_cpu(struct gb_s *gb){
 
     case 0xC9: /* RET */
     {
-        uint16_t temp = __gb_read(gb, gb->cpu_reg.sp++);
-        temp |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
-        gb->cpu_reg.pc = temp;
+        uint16_t temp = __gb_read(gb, cpu->sp++);
+        temp |= __gb_read(gb, cpu->sp++) << 8;
+        cpu->pc = temp;
         break;
     }
 
     case 0xCA: /* JP Z, imm */
-        if(gb->cpu_reg.f_bits.z){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            gb->cpu_reg.pc = temp;
+        if(!cpu->f_z){
+            uint16_t temp = imm;
+            cpu->pc = temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xCB: /* CB INST */
-        inst_cycles = __gb_execute_cb(gb);
+        inst_cycles = __gb_execute_cb(gb, cpu, imm);
+#ifdef GB_PROFILE
+        gb->profile.cb_count[imm]++;
+        gb->profile.cb_cycles[imm] += inst_cycles;
+#endif
         break;
 
     case 0xCC: /* CALL Z, imm */
-        if(gb->cpu_reg.f_bits.z){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-            gb->cpu_reg.pc = temp;
+        if(!cpu->f_z){
+            uint16_t temp = imm;
+            __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+            __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+            cpu->pc = temp;
             inst_cycles += 12;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xCD: /* CALL imm */
     {
-        uint16_t addr = __gb_read(gb, gb->cpu_reg.pc++);
-        addr |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = addr;
+        uint16_t addr = imm;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = addr;
     }
     break;
 
     case 0xCE: /* ADC A, imm */
     {
         uint8_t value, a, carry;
-        value = __gb_read(gb, gb->cpu_reg.pc++);
-        a = gb->cpu_reg.a;
-        carry = gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.a = a + value + carry;
+        value = imm;
+        a = cpu->a;
+        carry = (cpu->f_c & 1);
+        cpu->a = a + value + carry;
 
-        gb->cpu_reg.f_bits.z = gb->cpu_reg.a == 0 ? 1 : 0;
-        gb->cpu_reg.f_bits.h =
-            ((a & 0xF) + (value & 0xF) + carry > 0x0F) ? 1 : 0;
-        gb->cpu_reg.f_bits.c =
-            (((uint16_t) a) + ((uint16_t) value) + carry > 0xFF) ? 1 : 0;
-        gb->cpu_reg.f_bits.n = 0;
+        cpu->f_z = cpu->a;
+        cpu->f_h = ((a & 0xF) + (value & 0xF) + carry > 0x0F) ? 0x10 : 0;
+        cpu->f_c = (((uint16_t) a) + ((uint16_t) value) + carry > 0xFF) ? 1 : 0;
+        cpu->f_n = 0;
         break;
     }
 
     case 0xCF: /* RST 0x0008 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0008 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0008 + gb->load_address;
         break;
 
     case 0xD0: /* RET NC */
-        if(!gb->cpu_reg.f_bits.c){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.sp++);
-            temp |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
-            gb->cpu_reg.pc = temp;
+        if(!(cpu->f_c & 1)){
+            uint16_t temp = __gb_read(gb, cpu->sp++);
+            temp |= __gb_read(gb, cpu->sp++) << 8;
+            cpu->pc = temp;
             inst_cycles += 12;
         }
 
         break;
 
     case 0xD1: /* POP DE */
-        gb->cpu_reg.e = __gb_read(gb, gb->cpu_reg.sp++);
-        gb->cpu_reg.d = __gb_read(gb, gb->cpu_reg.sp++);
+        cpu->e = __gb_read(gb, cpu->sp++);
+        cpu->d = __gb_read(gb, cpu->sp++);
         break;
 
     case 0xD2: /* JP NC, imm */
-        if(!gb->cpu_reg.f_bits.c){
-            uint16_t temp =  __gb_read(gb, gb->cpu_reg.pc++);
-            temp |=  __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            gb->cpu_reg.pc = temp;
+        if(!(cpu->f_c & 1)){
+            uint16_t temp = imm;
+            cpu->pc = temp;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xD4: /* CALL NC, imm */
-        if(!gb->cpu_reg.f_bits.c){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-            gb->cpu_reg.pc = temp;
+        if(!(cpu->f_c & 1)){
+            uint16_t temp = imm;
+            __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+            __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+            cpu->pc = temp;
             inst_cycles += 12;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xD5: /* PUSH DE */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.d);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.e);
+        __gb_write(gb, --cpu->sp, cpu->d);
+        __gb_write(gb, --cpu->sp, cpu->e);
         break;
 
     case 0xD6: /* SUB imm */
     {
-        uint8_t val = __gb_read(gb, gb->cpu_reg.pc++);
-        uint16_t temp = gb->cpu_reg.a - val;
-        gb->cpu_reg.f_bits.z = ((temp & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ val ^ temp) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp & 0xFF);
+        uint8_t val = imm;
+        uint16_t temp = cpu->a - val;
+        cpu->f_z = temp;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ val ^ temp;
+        cpu->f_c = temp >> 8;
+        cpu->a = (temp & 0xFF);
         break;
     }
 
     case 0xD7: /* RST 0x0010 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0010 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0010 + gb->load_address;
         break;
 
     case 0xD8: /* RET C */
-        if(gb->cpu_reg.f_bits.c){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.sp++);
-            temp |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
-            gb->cpu_reg.pc = temp;
+        if((cpu->f_c & 1)){
+            uint16_t temp = __gb_read(gb, cpu->sp++);
+            temp |= __gb_read(gb, cpu->sp++) << 8;
+            cpu->pc = temp;
             inst_cycles += 12;
         }
 
@@ -2585,148 +2586,137 @@ void __gb_step_cpu(struct gb_s *gb){
 
     case 0xD9: /* RETI */
     {
-        uint16_t temp = __gb_read(gb, gb->cpu_reg.sp++);
-        temp |= __gb_read(gb, gb->cpu_reg.sp++) << 8;
-        gb->cpu_reg.pc = temp;
+        uint16_t temp = __gb_read(gb, cpu->sp++);
+        temp |= __gb_read(gb, cpu->sp++) << 8;
+        cpu->pc = temp;
         gb->gb_ime = 1;
+        gb->intr_due = 1;
     }
     break;
 
     case 0xDA: /* JP C, imm */
-        if(gb->cpu_reg.f_bits.c){
-            uint16_t addr = __gb_read(gb, gb->cpu_reg.pc++);
-            addr |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            gb->cpu_reg.pc = addr;
+        if((cpu->f_c & 1)){
+            uint16_t addr = imm;
+            cpu->pc = addr;
             inst_cycles += 4;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xDC: /* CALL C, imm */
-        if(gb->cpu_reg.f_bits.c){
-            uint16_t temp = __gb_read(gb, gb->cpu_reg.pc++);
-            temp |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-            __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-            gb->cpu_reg.pc = temp;
+        if((cpu->f_c & 1)){
+            uint16_t temp = imm;
+            __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+            __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+            cpu->pc = temp;
             inst_cycles += 12;
         }
-        else
-            gb->cpu_reg.pc += 2;
 
         break;
 
     case 0xDE: /* SBC A, imm */
     {
-        uint8_t temp_8 = __gb_read(gb, gb->cpu_reg.pc++);
-        uint16_t temp_16 = gb->cpu_reg.a - temp_8 - gb->cpu_reg.f_bits.c;
-        gb->cpu_reg.f_bits.z = ((temp_16 & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h =
-            (gb->cpu_reg.a ^ temp_8 ^ temp_16) & 0x10 ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp_16 & 0xFF00) ? 1 : 0;
-        gb->cpu_reg.a = (temp_16 & 0xFF);
+        uint8_t temp_8 = imm;
+        uint16_t temp_16 = cpu->a - temp_8 - (cpu->f_c & 1);
+        cpu->f_z = temp_16;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ temp_8 ^ temp_16;
+        cpu->f_c = temp_16 >> 8;
+        cpu->a = (temp_16 & 0xFF);
         break;
     }
 
     case 0xDF: /* RST 0x0018 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0018 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0018 + gb->load_address;
         break;
 
     case 0xE0: /* LD (0xFF00+imm), A */
-        __gb_write(gb, 0xFF00 | __gb_read(gb, gb->cpu_reg.pc++),
-               gb->cpu_reg.a);
+        __gb_write(gb, 0xFF00 | imm,
+               cpu->a);
         break;
 
     case 0xE1: /* POP HL */
-        gb->cpu_reg.l = __gb_read(gb, gb->cpu_reg.sp++);
-        gb->cpu_reg.h = __gb_read(gb, gb->cpu_reg.sp++);
+        cpu->l = __gb_read(gb, cpu->sp++);
+        cpu->h = __gb_read(gb, cpu->sp++);
         break;
 
     case 0xE2: /* LD (C), A */
-        __gb_write(gb, 0xFF00 | gb->cpu_reg.c, gb->cpu_reg.a);
+        __gb_write(gb, 0xFF00 | cpu->c, cpu->a);
         break;
 
     case 0xE5: /* PUSH HL */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.h);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.l);
+        __gb_write(gb, --cpu->sp, cpu->h);
+        __gb_write(gb, --cpu->sp, cpu->l);
         break;
 
     case 0xE6: /* AND imm */
         /* TODO: Optimisation? */
-        gb->cpu_reg.a = gb->cpu_reg.a & __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 1;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a & imm;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0x10;
+        cpu->f_c = 0;
         break;
 
     case 0xE7: /* RST 0x0020 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0020 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0020 + gb->load_address;
         break;
 
     case 0xE8: /* ADD SP, imm */
     {
-        int8_t offset = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
+        int8_t offset = (int8_t) imm;
         /* TODO: Move flag assignments for optimisation. */
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.sp & 0xF) + (offset & 0xF) > 0xF) ? 1 : 0;
-        gb->cpu_reg.f_bits.c = ((gb->cpu_reg.sp & 0xFF) + (offset & 0xFF) > 0xFF);
-        gb->cpu_reg.sp += offset;
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->sp & 0xF) + (offset & 0xF) > 0xF) ? 0x10 : 0;
+        cpu->f_c = ((cpu->sp & 0xFF) + (offset & 0xFF) > 0xFF);
+        cpu->sp += offset;
         break;
     }
 
     case 0xE9: /* JP HL */
-        gb->cpu_reg.pc = gb->cpu_reg.hl;
+        cpu->pc = cpu->hl;
         break;
 
     case 0xEA: /* LD (imm), A */
     {
-        uint16_t addr = __gb_read(gb, gb->cpu_reg.pc++);
-        addr |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-        __gb_write(gb, addr, gb->cpu_reg.a);
+        uint16_t addr = imm;
+        __gb_write(gb, addr, cpu->a);
         break;
     }
 
     case 0xEE: /* XOR imm */
-        gb->cpu_reg.a = gb->cpu_reg.a ^ __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a ^ imm;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xEF: /* RST 0x0028 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0028 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0028 + gb->load_address;
         break;
 
     case 0xF0: /* LD A, (0xFF00+imm) */
-        gb->cpu_reg.a =
-            __gb_read(gb, 0xFF00 | __gb_read(gb, gb->cpu_reg.pc++));
+        cpu->a =
+            __gb_read(gb, 0xFF00 | imm);
         break;
 
     case 0xF1: /* POP AF */
     {
-        uint8_t temp_8 = __gb_read(gb, gb->cpu_reg.sp++);
-        gb->cpu_reg.f_bits.z = (temp_8 >> 7) & 1;
-        gb->cpu_reg.f_bits.n = (temp_8 >> 6) & 1;
-        gb->cpu_reg.f_bits.h = (temp_8 >> 5) & 1;
-        gb->cpu_reg.f_bits.c = (temp_8 >> 4) & 1;
-        gb->cpu_reg.a = __gb_read(gb, gb->cpu_reg.sp++);
+        __gb_set_f(cpu, __gb_read(gb, cpu->sp++));
+        cpu->a = __gb_read(gb, cpu->sp++);
         break;
     }
 
     case 0xF2: /* LD A, (C) */
-        gb->cpu_reg.a = __gb_read(gb, 0xFF00 | gb->cpu_reg.c);
+        cpu->a = __gb_read(gb, 0xFF00 | cpu->c);
         break;
 
     case 0xF3: /* DI */
@@ -2734,74 +2724,90 @@ void __gb_step_cpu(struct gb_s *gb){
         break;
 
     case 0xF5: /* PUSH AF */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.a);
-        __gb_write(gb, --gb->cpu_reg.sp,
-               gb->cpu_reg.f_bits.z << 7 | gb->cpu_reg.f_bits.n << 6 |
-               gb->cpu_reg.f_bits.h << 5 | gb->cpu_reg.f_bits.c << 4);
+        __gb_write(gb, --cpu->sp, cpu->a);
+        __gb_write(gb, --cpu->sp, __gb_get_f(cpu));
         break;
 
     case 0xF6: /* OR imm */
-        gb->cpu_reg.a = gb->cpu_reg.a | __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.f_bits.z = (gb->cpu_reg.a == 0x00);
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = 0;
-        gb->cpu_reg.f_bits.c = 0;
+        cpu->a = cpu->a | imm;
+        cpu->f_z = cpu->a;
+        cpu->f_n = 0;
+        cpu->f_h = 0;
+        cpu->f_c = 0;
         break;
 
     case 0xF7: /* RST 0x0030 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0030 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0030 + gb->load_address;
         break;
 
     case 0xF8: /* LD HL, SP+/-imm */
     {
         /* Taken from SameBoy, which is released under MIT Licence. */
-        int8_t offset = (int8_t) __gb_read(gb, gb->cpu_reg.pc++);
-        gb->cpu_reg.hl = gb->cpu_reg.sp + offset;
-        gb->cpu_reg.f_bits.z = 0;
-        gb->cpu_reg.f_bits.n = 0;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.sp & 0xF) + (offset & 0xF) > 0xF) ? 1 : 0;
-        gb->cpu_reg.f_bits.c = ((gb->cpu_reg.sp & 0xFF) + (offset & 0xFF) > 0xFF) ? 1 : 0;
+        int8_t offset = (int8_t) imm;
+        cpu->hl = cpu->sp + offset;
+        cpu->f_z = 1;
+        cpu->f_n = 0;
+        cpu->f_h = ((cpu->sp & 0xF) + (offset & 0xF) > 0xF) ? 0x10 : 0;
+        cpu->f_c = ((cpu->sp & 0xFF) + (offset & 0xFF) > 0xFF) ? 1 : 0;
         break;
     }
 
     case 0xF9: /* LD SP, HL */
-        gb->cpu_reg.sp = gb->cpu_reg.hl;
+        cpu->sp = cpu->hl;
         break;
 
     case 0xFA: /* LD A, (imm) */
     {
-        uint16_t addr = __gb_read(gb, gb->cpu_reg.pc++);
-        addr |= __gb_read(gb, gb->cpu_reg.pc++) << 8;
-        gb->cpu_reg.a = __gb_read(gb, addr);
+        uint16_t addr = imm;
+        cpu->a = __gb_read(gb, addr);
         break;
     }
 
     case 0xFB: /* EI */
         gb->gb_ime = 1;
+        gb->intr_due = 1;
         break;
 
     case 0xFE: /* CP imm */
     {
-        uint8_t temp_8 = __gb_read(gb, gb->cpu_reg.pc++);
-        uint16_t temp_16 = gb->cpu_reg.a - temp_8;
-        gb->cpu_reg.f_bits.z = ((temp_16 & 0xFF) == 0x00);
-        gb->cpu_reg.f_bits.n = 1;
-        gb->cpu_reg.f_bits.h = ((gb->cpu_reg.a ^ temp_8 ^ temp_16) & 0x10) ? 1 : 0;
-        gb->cpu_reg.f_bits.c = (temp_16 & 0xFF00) ? 1 : 0;
+        uint8_t temp_8 = imm;
+        uint16_t temp_16 = cpu->a - temp_8;
+        cpu->f_z = temp_16;
+        cpu->f_n = 1;
+        cpu->f_h = cpu->a ^ temp_8 ^ temp_16;
+        cpu->f_c = temp_16 >> 8;
         break;
     }
 
     case 0xFF: /* RST 0x0038 */
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc >> 8);
-        __gb_write(gb, --gb->cpu_reg.sp, gb->cpu_reg.pc & 0xFF);
-        gb->cpu_reg.pc = 0x0038 + gb->load_address;
+        __gb_write(gb, --cpu->sp, cpu->pc >> 8);
+        __gb_write(gb, --cpu->sp, cpu->pc & 0xFF);
+        cpu->pc = 0x0038 + gb->load_address;
         break;
     }
 
+    return inst_cycles;
+}
+
+/**
+ * Internal function used to request an interrupt from one of the sources.
+ */
+static inline void __gb_raise_intr(struct gb_s *gb, uint8_t intr){
+    gb->gb_reg.IF |= intr;
+    gb->intr_pending |= intr & gb->gb_reg.IE;
+    gb->intr_due = 1;
+}
+
+/**
+ * Internal function used to move the timers and the LCD on by cycles.
+ */
+static inline void __gb_tick(struct gb_s *gb, uint_fast16_t cycles){
+    gb->frame_cycles -= cycles;
+
     /* DIV register timing */
-    gb->counter.div_count += inst_cycles;
+    gb->counter.div_count += cycles;
 
     if(gb->counter.div_count >= DIV_CYCLES){
         gb->gb_reg.DIV++;
@@ -2811,15 +2817,13 @@ void __gb_step_cpu(struct gb_s *gb){
     /* TIMA register timing */
     /* TODO: Change tac_enable to struct of TAC timer control bits. */
     if(gb->gb_reg.tac_enable){
-        static const uint_fast16_t TAC_CYCLES[4] = {1024, 16, 64, 256};
-
-        gb->counter.tima_count += inst_cycles;
+        gb->counter.tima_count += cycles;
 
         while(gb->counter.tima_count >= TAC_CYCLES[gb->gb_reg.tac_rate]){
             gb->counter.tima_count -= TAC_CYCLES[gb->gb_reg.tac_rate];
 
             if(++gb->gb_reg.TIMA == 0){
-                gb->gb_reg.IF |= TIMER_INTR;
+                __gb_raise_intr(gb, TIMER_INTR);
                 /* On overflow, set TMA to TIMA. */
                 gb->gb_reg.TIMA = gb->gb_reg.TMA;
             }
@@ -2827,9 +2831,9 @@ void __gb_step_cpu(struct gb_s *gb){
     }
 
     /* Audio */
-    /*gb->counter.apu_len_count += inst_cycles;
-    gb->counter.apu_swp_count += inst_cycles;
-    gb->counter.apu_env_count += inst_cycles;
+    /*gb->counter.apu_len_count += cycles;
+    gb->counter.apu_swp_count += cycles;
+    gb->counter.apu_env_count += cycles;
 
     if(gb->counter.apu_swp_count >= APU_SWP_CYCLES){
         if(gb->audio.ch1SweepCounterI && gb->audio.ch1SweepShift){
@@ -2930,7 +2934,7 @@ void __gb_step_cpu(struct gb_s *gb){
         return;
 
     /* LCD Timing */
-    gb->counter.lcd_count += inst_cycles;
+    gb->counter.lcd_count += cycles;
 
     /* New Scanline */
     if(gb->counter.lcd_count > LCD_LINE_CYCLES){
@@ -2941,7 +2945,7 @@ void __gb_step_cpu(struct gb_s *gb){
             gb->gb_reg.STAT |= STAT_LYC_COINC;
 
             if(gb->gb_reg.STAT & STAT_LYC_INTR)
-                gb->gb_reg.IF |= LCDC_INTR;
+                __gb_raise_intr(gb, LCDC_INTR);
         }
         else
             gb->gb_reg.STAT &= 0xFB;
@@ -2952,11 +2956,10 @@ void __gb_step_cpu(struct gb_s *gb){
         /* VBLANK Start */
         if(gb->gb_reg.LY == LCD_HEIGHT){
             gb->lcd_mode = LCD_VBLANK;
-            gb->gb_frame = 1;
-            gb->gb_reg.IF |= VBLANK_INTR;
+            __gb_raise_intr(gb, VBLANK_INTR);
 
             if(gb->gb_reg.STAT & STAT_MODE_1_INTR)
-                gb->gb_reg.IF |= LCDC_INTR;
+                __gb_raise_intr(gb, LCDC_INTR);
         }
         /* Normal Line */
         else if(gb->gb_reg.LY < LCD_HEIGHT){
@@ -2964,7 +2967,7 @@ void __gb_step_cpu(struct gb_s *gb){
             gb->lcd_mode = LCD_HBLANK;
 
             if(gb->gb_reg.STAT & STAT_MODE_0_INTR)
-                gb->gb_reg.IF |= LCDC_INTR;
+                __gb_raise_intr(gb, LCDC_INTR);
         }
     }
     /* OAM access */
@@ -2973,7 +2976,7 @@ void __gb_step_cpu(struct gb_s *gb){
         gb->lcd_mode = LCD_SEARCH_OAM;
 
         if(gb->gb_reg.STAT & STAT_MODE_2_INTR)
-            gb->gb_reg.IF |= LCDC_INTR;
+            __gb_raise_intr(gb, LCDC_INTR);
     }
     /* Update LCD */
     else if(gb->lcd_mode == LCD_SEARCH_OAM
@@ -2982,10 +2985,531 @@ void __gb_step_cpu(struct gb_s *gb){
     }
 }
 
+#if GB_BLOCK_ENTRIES
+/**
+ * Internal function used to work out how many cycles can pass before
+ * __gb_tick has anything more to do than count them, or the frame is done.
+ */
+static inline uint_fast16_t __gb_block_budget(struct gb_s *gb){
+    int_fast32_t budget = MIN(DIV_CYCLES - (int_fast32_t)gb->counter.div_count, gb->frame_cycles);
+
+    if(gb->gb_reg.tac_enable)
+        budget = MIN(budget, (int_fast32_t)TAC_CYCLES[gb->gb_reg.tac_rate] - (int_fast32_t)gb->counter.tima_count);
+
+    if(gb->gb_reg.LCDC & LCDC_ENABLE){
+        int_fast32_t lcd = gb->counter.lcd_count;
+
+        budget = MIN(budget, LCD_LINE_CYCLES + 1 - lcd);
+        if(gb->lcd_mode == LCD_HBLANK)
+            budget = MIN(budget, LCD_MODE_2_CYCLES - lcd);
+        else if(gb->lcd_mode == LCD_SEARCH_OAM)
+            budget = MIN(budget, LCD_MODE_3_CYCLES - lcd);
+    }
+    return budget > 0 ? budget : 0;
+}
+#endif
+
+/**
+ * Internal function used to push PC for an interrupt. The stack is in WRAM
+ * or HRAM for nearly every GBS, and is written there directly, unless every
+ * write has to be seen.
+ */
+static inline void __gb_push_pc(struct gb_s *gb){
+    uint16_t sp = gb->cpu_reg.sp - 2;
+    uint16_t pc = gb->cpu_reg.pc;
+
+#if !defined(GB_PROFILE) && !defined(GB_WATCH)
+    if(sp >= WRAM_0_ADDR && sp < ECHO_ADDR - 1){
+        gb->wram[sp - WRAM_0_ADDR] = pc & 0xFF;
+        gb->wram[sp - WRAM_0_ADDR + 1] = pc >> 8;
+    }
+    else if(sp >= HRAM_ADDR && sp < INTR_EN_ADDR - 1){
+        gb->hram[sp - IO_ADDR] = pc & 0xFF;
+        gb->hram[sp - IO_ADDR + 1] = pc >> 8;
+    }
+    else
+#endif
+    {
+        __gb_write(gb, (uint16_t)(sp + 1), pc >> 8);
+        __gb_write(gb, sp, pc & 0xFF);
+    }
+    gb->cpu_reg.sp = sp;
+}
+
+/**
+ * Internal function used to take a pending interrupt: it wakes the CPU
+ * from HALT, and if interrupts are enabled, calls the play routine. Every
+ * source goes there in a GBS, so only the flag of the one taken (the
+ * lowest bit set, which has the highest priority) has to be worked out.
+ */
+static inline void __gb_interrupt(struct gb_s *gb){
+    gb->gb_halt = 0;
+    if(!gb->gb_ime)
+        return;
+
+    gb->gb_ime = 0;
+    __gb_push_pc(gb);
+    /* Pushing PC over IE can leave nothing to take. */
+    if(!gb->intr_pending)
+        return;
+
+    gb->cpu_reg.pc = gb->play_address;
+    gb->gb_reg.IF ^= gb->intr_pending & -gb->intr_pending;
+    gb->intr_pending = gb->gb_reg.IF & gb->gb_reg.IE & ANY_INTR;
+}
+
+/**
+ * Internal function used to step the CPU. Interrupts are looked at only
+ * when intr_due says something may have let one be taken: an event raising
+ * one, a write to IF or IE, EI, RETI or HALT.
+ */
+void __gb_step_cpu(struct gb_s *gb){
+    if(gb->cpu_reg.pc < 0x0010){  // Hack to help handle GBS: init and play return here to wait for the next interrupt
+        gb->cpu_reg.pc = 0;
+        gb->gb_halt = 1;
+        gb->gb_ime = 1;
+        gb->intr_due = 1;
+    }
+    uint8_t opcode, inst_cycles;
+    uint16_t imm = 0;
+
+    /* Handle interrupts */
+    if(gb->intr_due){
+        gb->intr_due = 0;
+        if(gb->intr_pending && (gb->gb_ime || gb->gb_halt))
+            __gb_interrupt(gb);
+    }
+
+    /* Obtain opcode */
+#ifdef GB_PROFILE
+    bool halted = gb->gb_halt;
+#endif
+    opcode = (gb->gb_halt ? 0x00 : __gb_fetch(gb, &imm));
+    inst_cycles = __gb_execute(gb, &gb->cpu_reg, opcode, imm);
+
+#ifdef GB_PROFILE
+    if(halted)
+        gb->profile.halt_cycles += inst_cycles;
+    else{
+        gb->profile.op_count[opcode]++;
+        gb->profile.op_cycles[opcode] += inst_cycles;
+    }
+#endif
+
+    __gb_tick(gb, inst_cycles);
+}
+
+#if GB_BLOCK_ENTRIES
+/**
+ * Internal function used to tell whether an instruction ends a block: it
+ * may jump, or changes the interrupt or halt state checked between blocks.
+ */
+static inline bool __gb_ends_block(uint8_t opcode){
+    switch(opcode){
+    case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:     /* JR */
+    case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9:  /* JP */
+    case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:     /* CALL */
+    case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:  /* RET, RETI */
+    case 0xC7: case 0xCF: case 0xD7: case 0xDF:                /* RST */
+    case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+    case 0x76: case 0xFB:                                      /* HALT, EI */
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Internal function used to tell whether an instruction can be part of an
+ * idle loop: it reads memory, or sets nothing but A and the flags, or it is
+ * the conditional branch that closes the loop. Returns its cycles (taken, for a branch), or 0 if it cannot.
+ */
+static inline uint8_t __gb_idle_cycles(uint8_t opcode, uint16_t imm){
+    switch(opcode){
+    case 0x0A: case 0x1A: case 0x7E:                            /* LD A,(rr) */
+    case 0xA6: case 0xB6: case 0xBE:                            /* AND/OR/CP (HL) */
+    case 0xE6: case 0xF6: case 0xFE:                            /* AND/OR/CP n */
+        return 8;
+    case 0xA0: case 0xA1: case 0xA2: case 0xA3: case 0xA4: case 0xA5: case 0xA7:
+    case 0xB0: case 0xB1: case 0xB2: case 0xB3: case 0xB4: case 0xB5: case 0xB7:
+    case 0xB8: case 0xB9: case 0xBA: case 0xBB: case 0xBC: case 0xBD: case 0xBF:
+    case 0xAF:                                                  /* XOR A */
+        return 4;
+    case 0xF0:                                                  /* LDH A,(n) */
+    case 0x20: case 0x28: case 0x30: case 0x38:                 /* JR cc */
+        return 12;
+    case 0xFA:                                                  /* LD A,(nn) */
+    case 0xC2: case 0xCA: case 0xD2: case 0xDA:                 /* JP cc */
+        return 16;
+    case 0xCB:                                                  /* BIT */
+        if((imm & 0xC0) != 0x40)
+            return 0;
+        return (imm & 0x07) == 0x06 ? 12 : 8;
+    }
+    return 0;
+}
+
+/**
+ * Internal function used to tell whether a block that ends at end is an idle
+ * loop: one that branches back to start, with nothing on the way but
+ * instructions that __gb_idle_cycles allows. Each pass then leaves the
+ * registers as the one before, until what it reads changes, and with no
+ * writes that is only at a timer or LCD event. Returns the cycles of one
+ * pass, or 0 if it is not one.
+ */
+static uint8_t __gb_idle_loop(const struct gb_block_s *b, uint16_t start, uint16_t end){
+    const struct gb_block_op_s *last = &b->op[b->count - 1];
+    uint_fast16_t cycles = 0;
+
+    switch(last->opcode){
+    case 0x20: case 0x28: case 0x30: case 0x38:
+        if((uint16_t)(end + (int8_t)last->imm) != start)
+            return 0;
+        break;
+    case 0xC2: case 0xCA: case 0xD2: case 0xDA:
+        if(last->imm != start)
+            return 0;
+        break;
+    default:
+        return 0;
+    }
+
+    for(const struct gb_block_op_s *op = b->op; op <= last; op++){
+        uint8_t c = __gb_idle_cycles(op->opcode, op->imm);
+
+        if(!c)
+            return 0;
+        cycles += c;
+    }
+    return cycles;
+}
+
+/**
+ * Internal function used to count the cycles of each instruction run in a
+ * block. Once they reach the budget the timers and LCD are ticked, and it
+ * returns true: the run ends there.
+ */
+static inline bool __gb_block_end(struct gb_s *gb, uint_fast16_t cycles){
+    gb->block_cycles += cycles;
+    if(gb->block_cycles < gb->block_budget)
+        return false;
+
+    __gb_tick(gb, gb->block_cycles);
+    gb->block_cycles = 0;
+    return true;
+}
+
+#ifdef GB_AOT
+#include GB_AOT
+#endif
+
+/**
+ * Internal function used to translate the code at pc into a block, up to
+ * and including the first instruction that ends one. Common driver idioms
+ * are fused into superinstructions on the way. A block never runs on into
+ * the next 16 KB of the address space, so it stays within one ROM bank, and
+ * it stops short of opcodes the SM83 does not have.
+ */
+void __gb_translate(struct gb_s *gb, struct gb_block_s *b, uint16_t pc, uint32_t tag){
+    const uint16_t start = pc;
+
+    b->tag = tag;
+    b->count = 0;
+    b->idle = 0;
+#ifdef GB_AOT
+    b->aot = gb->aot ? gb_aot_find(tag) : NULL;
+#endif
+
+    while(b->count < GB_BLOCK_OPS){
+        struct gb_block_op_s *op = &b->op[b->count];
+        uint_fast16_t left = ROM_BANK_SIZE - (pc & (ROM_BANK_SIZE - 1));
+        uint8_t opcode;
+
+        if(b->count && left == ROM_BANK_SIZE)
+            return;
+        opcode = __gb_read(gb, pc);
+
+        /* The opcodes the SM83 lacks stand for superinstructions here. */
+        switch(opcode){
+        case 0xD3: case 0xDB: case 0xDD: case 0xE3: case 0xE4: case 0xEB:
+        case 0xEC: case 0xED: case 0xF4: case 0xFC: case 0xFD:
+            return;
+        }
+
+        op->opcode = opcode;
+        op->length = GB_OP_LENGTH[opcode];
+        if(op->length > left)
+            return;
+        op->imm = op->length > 1 ? __gb_read(gb, pc + 1) : 0;
+        if(op->length > 2) op->imm |= __gb_read(gb, pc + 2) << 8;
+
+        if(opcode == 0x2A && left >= 3 && __gb_read(gb, pc + 1) == 0xE0){
+            op->opcode = GB_OP_LDI_LDH;
+            op->length = 3;
+            op->imm = __gb_read(gb, pc + 2);
+        }
+        else if((opcode == 0x05 || opcode == 0x0D) && left >= 3 && __gb_read(gb, pc + 1) == 0x20){
+            op->opcode = opcode == 0x05 ? GB_OP_DEC_B_JRNZ : GB_OP_DEC_C_JRNZ;
+            op->length = 3;
+            op->imm = __gb_read(gb, pc + 2);
+            opcode = 0x20;
+        }
+        else if((opcode == 0x0C || opcode == 0x1C || opcode == 0x2C) && left >= 4 &&
+                __gb_read(gb, pc + 1) == 0x20 && __gb_read(gb, pc + 2) == 0x01 &&
+                __gb_read(gb, pc + 3) == opcode - 0x08){
+            op->opcode = opcode == 0x0C ? GB_OP_INC_BC : (opcode == 0x1C ? GB_OP_INC_DE : GB_OP_INC_HL);
+            op->length = 4;
+        }
+
+        b->count++;
+        pc += op->length;
+        if(__gb_ends_block(opcode)){
+            b->idle = __gb_idle_loop(b, start, pc);
+            return;
+        }
+    }
+}
+
+/**
+ * Internal function used to run INC low, JR NZ over the next, INC high: a
+ * 16 bit increment that leaves the flags as the last INC did. Takes 16
+ * cycles either way. Returns the number of instructions run.
+ */
+static inline uint32_t __gb_inc16(struct cpu_registers_s *cpu, uint8_t *low, uint8_t *high){
+    (*low)++;
+    cpu->f_z = *low;
+    cpu->f_n = 0;
+    cpu->f_h = ((*low & 0x0F) == 0x00) << 4;
+    if(*low)
+        return 2;
+
+    (*high)++;
+    cpu->f_z = *high;
+    cpu->f_h = ((*high & 0x0F) == 0x00) << 4;
+    return 3;
+}
+
+/**
+ * Internal function used to step into a superinstruction that an event
+ * falls within, instead of running it fused, from the registers of the
+ * run in cpu. Returns the number of instructions run.
+ */
+uint32_t __gb_block_split(struct gb_s *gb, const struct cpu_registers_s *cpu, const struct gb_block_op_s *op){
+    __gb_tick(gb, gb->block_cycles);
+    gb->block_cycles = 0;
+    gb->cpu_reg = *cpu;
+    gb->cpu_reg.pc -= op->length;
+    __gb_step_cpu(gb);
+    return 1;
+}
+
+/**
+ * Internal function used to run translated blocks from PC, one after
+ * another, up to the next timer or LCD event, taking interrupts between
+ * them. Code in RAM and the GBS return stub go through __gb_step_cpu
+ * instead.
+ * Returns the number of instructions run.
+ *
+ * A halted CPU, and an idle loop once it has gone round, would do the same
+ * thing until the event: the time up to it is counted in one go, with the
+ * instructions that stepping would have run. A halted CPU goes on like
+ * that from event to event, until one raises an interrupt or the frame is
+ * done.
+ *
+ * The timers and LCD are ticked once per run rather than after every
+ * instruction, with the same results: blocks run on without ticking only
+ * as long as no event can come due (the budget), and the run ends with the
+ * instruction that reaches it, so that the caller sees the frame end or an
+ * interrupt where stepping would. Touching an I/O register brings the
+ * counters up to date first, and writing one or switching the ROM bank
+ * ends the run.
+ *
+ * The registers are copied into cpu for the run, so that the compiler can
+ * keep them in CPU registers instead of going back to gb after every
+ * memory access, and copied back wherever it ends or steps.
+ */
+uint32_t __gb_run_block(struct gb_s *gb){
+    struct cpu_registers_s cpu = gb->cpu_reg;
+    uint32_t instructions = 0;
+    uint32_t prev = UINT32_MAX;
+
+    gb->block_cycles = 0;
+    gb->block_budget = __gb_block_budget(gb);
+
+    for(;;){
+        uint16_t pc = cpu.pc;
+        uint32_t tag = pc >= ROM_N_ADDR ? pc | (gb->selected_rom_bank << 16) : pc;
+        struct gb_block_s *b = &gb->block[(pc ^ (pc >> 6)) & (GB_BLOCK_ENTRIES - 1)];
+
+        if(gb->intr_pending && (gb->gb_ime || gb->gb_halt) && (gb->gb_halt || pc >= 0x0010)){
+            /* Taken here rather than stepped, unless the GBS return stub
+             * has to run first. */
+            gb->cpu_reg = cpu;
+            __gb_interrupt(gb);
+            cpu = gb->cpu_reg;
+            prev = UINT32_MAX;
+            continue;
+        }
+        if(gb->gb_halt){
+            /* Halted, the CPU runs NOPs until an event raises an interrupt:
+             * go straight from one event to the next, up to the one that
+             * does or the end of the frame. */
+            gb->cpu_reg = cpu;
+            do{
+                uint_fast16_t nops = (gb->block_budget - gb->block_cycles + 3) / 4;
+
+                if(!nops)
+                    nops = 1;
+                __gb_block_end(gb, nops * 4);
+                instructions += nops;
+                gb->block_budget = __gb_block_budget(gb);
+            }while(gb->frame_cycles > 0 && !gb->intr_pending);
+            return instructions;
+        }
+        if(pc < 0x0010 || pc >= VRAM_ADDR)
+            break;
+        if(b->tag != tag)
+            __gb_translate(gb, b, pc, tag);
+        if(tag == prev && b->idle){
+            /* Gone round an idle loop once: the passes up to the one that
+             * reaches the next event would all go the same way. */
+            uint_fast16_t passes = (gb->block_budget - gb->block_cycles - 1) / b->idle;
+
+            gb->block_cycles += passes * b->idle;
+            instructions += passes * b->count;
+        }
+        prev = tag;
+#ifdef GB_AOT
+        if(b->aot){
+            /* They keep their own copy of the registers. */
+            gb->cpu_reg = cpu;
+            if(b->aot(gb, &instructions))
+                return instructions;
+            cpu = gb->cpu_reg;
+            continue;
+        }
+#endif
+        if(!b->count)
+            break;
+
+        for(const struct gb_block_op_s *op = b->op; op < b->op + b->count; op++){
+            uint8_t cycles;
+
+            cpu.pc += op->length;
+
+            switch(op->opcode){
+            /* Superinstructions run fused only if no event comes due before
+             * their last part, where stepping would stop. */
+            case GB_OP_LDI_LDH:
+                if(gb->block_cycles + 8 >= gb->block_budget)
+                    return instructions + __gb_block_split(gb, &cpu, op);
+                cpu.a = __gb_read(gb, cpu.hl++);
+                gb->block_cycles += 8;
+                __gb_write(gb, 0xFF00 | op->imm, cpu.a);
+                cycles = 12;
+                instructions += 2;
+                break;
+
+            case GB_OP_DEC_B_JRNZ:
+            case GB_OP_DEC_C_JRNZ:
+            {
+                uint8_t r;
+
+                if(gb->block_cycles + 4 >= gb->block_budget)
+                    return instructions + __gb_block_split(gb, &cpu, op);
+                if(op->opcode == GB_OP_DEC_B_JRNZ)
+                    r = --cpu.b;
+                else
+                    r = --cpu.c;
+                cpu.f_z = r;
+                cpu.f_n = 1;
+                cpu.f_h = ((r & 0x0F) == 0x0F) << 4;
+                cycles = 12;
+                if(r){
+                    cpu.pc += (int8_t)op->imm;
+                    cycles += 4;
+                }
+                instructions += 2;
+                break;
+            }
+
+            case GB_OP_INC_BC:
+            case GB_OP_INC_DE:
+            case GB_OP_INC_HL:
+                if(gb->block_cycles + 12 >= gb->block_budget)
+                    return instructions + __gb_block_split(gb, &cpu, op);
+                if(op->opcode == GB_OP_INC_BC)
+                    instructions += __gb_inc16(&cpu, &cpu.c, &cpu.b);
+                else if(op->opcode == GB_OP_INC_DE)
+                    instructions += __gb_inc16(&cpu, &cpu.e, &cpu.d);
+                else
+                    instructions += __gb_inc16(&cpu, &cpu.l, &cpu.h);
+                cycles = 16;
+                break;
+
+            default:
+                cycles = __gb_execute(gb, &cpu, op->opcode, op->imm);
+                instructions++;
+                break;
+            }
+
+            if(__gb_block_end(gb, cycles)){
+                gb->cpu_reg = cpu;
+                return instructions;
+            }
+        }
+    }
+
+    gb->cpu_reg = cpu;
+    /* Nothing is due, so this only brings the counters up to date. */
+    __gb_tick(gb, gb->block_cycles);
+    gb->block_cycles = 0;
+    if(!instructions){
+        __gb_step_cpu(gb);
+        return 1;
+    }
+    return instructions;
+}
+#endif
+
+/**
+ * Emulates one frame: the T-cycles from the start of this frame of audio
+ * to the start of the next, counted from the song start by frame_clock, so
+ * that the play routine is called at the rate the GBS asks for (VBlank or
+ * its timer) against the samples the writes are heard at. The instruction
+ * that runs past the end of the frame is taken off the next one.
+ *
+ * If the queue runs short of room partway through, the frame is left open
+ * and the next call goes on with it, so that a frame with more writes than
+ * the queue holds never waits on a consumer that waits for the frame.
+ */
 void gb_run_frame(struct gb_s *gb){
-    gb->gb_frame = 0;
-    while(!gb->gb_frame)
+    uint32_t start = STATS_NOW();
+    uint32_t instructions = 0;
+
+    if(!gb->frame_open){
+        gb->frame_length = clock_step(&gb->frame_clock, 1);
+        gb->frame_cycles += gb->frame_length;
+        gb->frame_ticks = 0;
+        gb->frame_instructions = 0;
+    }
+    while(gb->frame_cycles > 0){
+        if(!reg_queue_run_room(gb->apu_queue)){
+            gb->frame_open = 1;
+            gb->frame_ticks += (STATS_NOW() - start) & STATS_TICK_MASK;
+            gb->frame_instructions += instructions;
+            return;
+        }
+#if GB_BLOCK_ENTRIES
+        instructions += __gb_run_block(gb);
+#else
         __gb_step_cpu(gb);
+        instructions++;
+#endif
+    }
+    gb->frame_open = 0;
+    stats_frame(gb->stats, gb->frame_ticks + ((STATS_NOW() - start) & STATS_TICK_MASK),
+            gb->frame_instructions + instructions);
+    reg_queue_end_frame(gb->apu_queue);
 }
 
 
@@ -2999,9 +3523,21 @@ void gb_init(struct gb_s *gb, uint8_t song){
 
     gb->selected_rom_bank = 1;
     gb->cart_ram_bank = 0;
-    gb->cart_ram_bank_offset = CART_RAM_ADDR;
     gb->enable_cart_ram = 0;
-    gb->cart_mode_select = 0;
+
+    /* Every song starts from the same memory, rather than from wherever the
+     * producer had got to in the last one when it was asked for this.
+     * Cartridge RAM banks are cleared in place, not freed, so that core 1
+     * does not allocate them again at every song. */
+    for(int i = 0; i < WRAM_SIZE; i++)
+        gb->wram[i] = 0;
+    for(int i = 0; i < HRAM_SIZE; i++)
+        gb->hram[i] = 0;
+    for(int i = 0; i < SRAM_BANKS; i++){
+        if(gb->sram[i])
+            for(int j = 0; j < SRAM_BANK_SIZE; j++)
+                gb->sram[i][j] = 0;
+    }
 
     /* Initialise CPU registers as though a DMG. */
     gb->cpu_reg.sp = gb->stack_pointer;
@@ -3012,6 +3548,10 @@ void gb_init(struct gb_s *gb, uint8_t song){
     gb->counter.lcd_count = 0;
     gb->counter.div_count = 0;
     gb->counter.tima_count = 0;
+    gb->frame_cycles = 0;
+    gb->frame_length = 0;
+    gb->frame_open = 0;
+    clock_init(&gb->frame_clock, CLOCK_FRAME_HZ, CLOCK_GB_HZ);
 
     gb->counter.apu_len_count = APU_LEN_CYCLES;
     gb->counter.apu_swp_count = APU_SWP_CYCLES - 16384;
@@ -3025,72 +3565,25 @@ void gb_init(struct gb_s *gb, uint8_t song){
     gb->gb_reg.IF        = 0xE1;
 
     gb->gb_reg.LCDC      = 0x91;
-    gb->gb_reg.SCY       = 0x00;
-    gb->gb_reg.SCX       = 0x00;
     gb->gb_reg.LYC       = 0x00;
 
-    gb->gb_reg.SB = 0x00;
-    gb->gb_reg.SC = 0x7E;
     gb->gb_reg.STAT = 0x85;
     gb->gb_reg.LY = 0x00;
 
-    __gb_write(gb, 0xFF10, 0x80);
-    __gb_write(gb, 0xFF11, 0xBF);
-    __gb_write(gb, 0xFF12, 0xF3);
-    __gb_write(gb, 0xFF13, 0xFF);
-    __gb_write(gb, 0xFF14, 0xBF);
-    __gb_write(gb, 0xFF15, 0xFF);
-    __gb_write(gb, 0xFF16, 0x3F);
-    __gb_write(gb, 0xFF17, 0x00);
-    __gb_write(gb, 0xFF18, 0xFF);
-    __gb_write(gb, 0xFF19, 0xBF);
-    __gb_write(gb, 0xFF1A, 0x7F);
-    __gb_write(gb, 0xFF1B, 0xFF);
-    __gb_write(gb, 0xFF1C, 0x9F);
-    __gb_write(gb, 0xFF1D, 0xFF);
-    __gb_write(gb, 0xFF1E, 0xBF);
-    __gb_write(gb, 0xFF1F, 0xFF);
-    __gb_write(gb, 0xFF20, 0xFF);
-    __gb_write(gb, 0xFF21, 0x00);
-    __gb_write(gb, 0xFF22, 0x00);
-    __gb_write(gb, 0xFF23, 0xBF);
-    __gb_write(gb, 0xFF24, 0x77);
-    __gb_write(gb, 0xFF25, 0xF3);
-    __gb_write(gb, 0xFF26, 0xF1);
-    __gb_write(gb, 0xFF27, 0xFF);
-    __gb_write(gb, 0xFF28, 0xFF);
-    __gb_write(gb, 0xFF29, 0xFF);
-    __gb_write(gb, 0xFF2A, 0xFF);
-    __gb_write(gb, 0xFF2B, 0xFF);
-    __gb_write(gb, 0xFF2C, 0xFF);
-    __gb_write(gb, 0xFF2D, 0xFF);
-    __gb_write(gb, 0xFF2E, 0xFF);
-    __gb_write(gb, 0xFF2F, 0xFF);
-
-    for(int i = 0; i < 0x20; i++) gb->audio.WAVRAM[i] = 0;
-    gb->audio.ch1Freq = 0;
-    gb->audio.ch1SweepCounter = 0;
-    gb->audio.ch1SweepCounterI = 0;
-    gb->audio.ch1SweepDir = 0;
-    gb->audio.ch1SweepShift = 0;
-    gb->audio.ch1Vol = gb->audio.ch2Vol = gb->audio.ch3Vol = gb->audio.ch4Vol = 0;
-    gb->audio.ch1VolI = gb->audio.ch2VolI = gb->audio.ch3VolI = gb->audio.ch4VolI = 0;
-    gb->audio.ch1Len = gb->audio.ch2Len = gb->audio.ch3Len = gb->audio.ch4Len = 0;
-    gb->audio.ch1LenI = gb->audio.ch2LenI = gb->audio.ch3LenI = gb->audio.ch4LenI = 0;
-    gb->audio.ch1LenOn = gb->audio.ch2LenOn = gb->audio.ch3LenOn = gb->audio.ch4LenOn = 0;
-    gb->audio.ch1EnvCounter = gb->audio.ch2EnvCounter = gb->audio.ch4EnvCounter = 0;
-    gb->audio.ch1EnvCounterI = gb->audio.ch2EnvCounterI = gb->audio.ch4EnvCounterI = 0;
-    gb->audio.ch1EnvDir = gb->audio.ch2EnvDir = gb->audio.ch4EnvDir = 0;
-    gb->audio.ch1DAC = gb->audio.ch2DAC = gb->audio.ch4DAC = 0;
-    gb->audio.idleTimer = 0;
-
-    if(gb->timer_control & 2){
+    /* The APU resets itself when it sees REG_EVENT_RESET, only the copy
+     * the CPU reads back is set here. */
+    for(uint8_t i = 0; i < 0x20; i++)
+        __gb_write_apu_shadow(gb, 0x10 + i, APU_INIT_REGS[i]);
+
+    if(gb->timer_control & 4){
         gb->gb_reg.IE = TIMER_INTR;
     }else{
         gb->gb_reg.IE = VBLANK_INTR;
     }
+    gb->intr_pending = gb->gb_reg.IF & gb->gb_reg.IE & ANY_INTR;
+    gb->intr_due = 1;
     gb->cpu_reg.a = song;
-    gb->cpu_reg.f = 0xB0;
+    __gb_set_f(&gb->cpu_reg, 0xB0);
     gb->cpu_reg.b = 0x00;
     gb->cpu_reg.c = 0x13;
     gb->cpu_reg.d = 0x00;
@@ -3098,3 +3591,128 @@ void gb_init(struct gb_s *gb, uint8_t song){
     gb->cpu_reg.h = 0x01;
     gb->cpu_reg.l = 0x4D;
 }
+
+
+/**
+ * Producer side of the audio pipeline. Starts a song if the consumer asked
+ * for one, then emulates one frame if the queue has room for it, or goes on
+ * with the one left open.
+ * Returns 0 if there was nothing to do.
+ */
+int gb_produce(struct gb_s *gb){
+    struct reg_queue_s *q = gb->apu_queue;
+    uint32_t seq = atomic_load_explicit(&q->song_seq, memory_order_acquire);
+
+    if(seq != gb->song_seq){
+        gb->song_seq = seq;
+        /* The reset goes between frames: one left open is cut short. */
+        if(gb->frame_open)
+            reg_queue_end_frame(q);
+        reg_queue_push(q, 0, REG_EVENT_RESET, seq & 0xFF);
+        gb_init(gb, atomic_load_explicit(&q->song, memory_order_relaxed));
+    }
+
+    /* No song requested yet. */
+    if(gb->song_seq == 0 || !(gb->frame_open ? reg_queue_run_room(q) : reg_queue_has_room(q)))
+        return 0;
+
+    gb_run_frame(gb);
+    return 1;
+}
+
+
+#ifdef GB_WATCH
+/**
+ * Has fn called, with user, before every write to the size bytes from addr.
+ * Watches stay set from one song to the next. The registers in gb are only
+ * brought up to date at the end of a run of translated blocks, so fn should
+ * not go by them. Returns false if GB_WATCHES are set already.
+ */
+bool gb_watch_add(struct gb_s *gb, uint16_t addr, uint16_t size, gb_watch_fn fn, void *user){
+    struct gb_watch_s *w;
+
+    if(gb->watch_count == GB_WATCHES || !size)
+        return false;
+
+    w = &gb->watch[gb->watch_count];
+    w->addr = addr;
+    w->size = size;
+    w->fn = fn;
+    w->user = user;
+    gb->watch_count++;
+    for(uint32_t page = addr >> 8; page <= (uint32_t)(addr + size - 1) >> 8 && page < 0x100; page++)
+        gb->watch_pages[page >> 3] |= 1 << (page & 7);
+    return true;
+}
+
+/**
+ * Removes every watch.
+ */
+void gb_watch_clear(struct gb_s *gb){
+    gb->watch_count = 0;
+    for(uint8_t i = 0; i < sizeof(gb->watch_pages); i++)
+        gb->watch_pages[i] = 0;
+}
+#endif
+
+
+/**
+ * Frees the cartridge RAM banks the GBS has written to.
+ */
+void gb_free_sram(struct gb_s *gb){
+    for(int i = 0; i < SRAM_BANKS; i++){
+        free(gb->sram[i]);
+        gb->sram[i] = NULL;
+    }
+}
+
+
+/**
+ * Hashes a whole GBS file (32 bit FNV-1a), to tell it from others.
+ */
+uint32_t gb_gbs_hash(const uint8_t *gbs, uint32_t size){
+    uint32_t h = 0x811C9DC5;
+
+    for(uint32_t i = 0; i < size; i++)
+        h = (h ^ gbs[i]) * 0x01000193;
+    return h;
+}
+
+/**
+ * Maps a GBS file as ROM and reads its header. The data is used in place,
+ * so it must stay around as long as the context is in use.
+ * Returns the number of songs, or 0 if this is not a GBS file.
+ */
+uint8_t gb_load_gbs(struct gb_s *gb, const uint8_t *gbs, uint32_t size){
+    if(size < 0x70 || gbs[0] != 'G' || gbs[1] != 'B' || gbs[2] != 'S')
+        return 0;
+
+    gb->song_count = gbs[0x04];
+    gb->first_song = gbs[0x05] - 1;
+    gb->load_address = gbs[0x06] + (gbs[0x07] << 8);
+    gb->init_address = gbs[0x08] + (gbs[0x09] << 8);
+    gb->play_address = gbs[0x0A] + (gbs[0x0B] << 8);
+    gb->stack_pointer = gbs[0x0C] + (gbs[0x0D] << 8);
+    gb->timer_modulo = gbs[0x0E];
+    gb->timer_control = gbs[0x0F];
+
+    gb->rom = gbs + 0x70;
+    gb->rom_size = size - 0x70;
+#if GB_DECODE_ENTRIES
+    for(int i = 0; i < GB_DECODE_ENTRIES; i++)
+        gb->decoded[i].tag = GB_DECODE_EMPTY;
+#endif
+#if GB_BLOCK_ENTRIES
+    for(int i = 0; i < GB_BLOCK_ENTRIES; i++)
+        gb->block[i].tag = GB_DECODE_EMPTY;
+#endif
+#ifdef GB_AOT
+    gb->aot = size == GB_AOT_SIZE && gb_gbs_hash(gbs, size) == GB_AOT_HASH;
+#endif
+    gb_free_sram(gb);
+    gb->song_seq = 0;
+#ifdef GB_PROFILE
+    gb->profile = (struct gb_profile_s){0};
+#endif
+    return gb->song_count;
+}
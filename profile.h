@@ -0,0 +1,163 @@
+/**
+ * Report for the profiling build (GB_PROFILE): which opcodes use the most
+ * emulated cycles, and which memory pages are accessed most, so we know
+ * what the interpreter should have fast paths for.
+ */
+
+#pragma once
+
+#ifdef GB_PROFILE
+
+static const char *const PROFILE_OP_NAMES[0x100] = {
+    "NOP", "LD BC, imm", "LD (BC), A", "INC BC",
+    "INC B", "DEC B", "LD B, imm", "RLCA",
+    "LD (imm), SP", "ADD HL, BC", "LD A, (BC)", "DEC BC",
+    "INC C", "DEC C", "LD C, imm", "RRCA",
+    "STOP", "LD DE, imm", "LD (DE), A", "INC DE",
+    "INC D", "DEC D", "LD D, imm", "RLA",
+    "JR imm", "ADD HL, DE", "LD A, (DE)", "DEC DE",
+    "INC E", "DEC E", "LD E, imm", "RRA",
+    "JR NZ, imm", "LD HL, imm", "LDI (HL), A", "INC HL",
+    "INC H", "DEC H", "LD H, imm", "DAA",
+    "JR Z, imm", "ADD HL, HL", "LD A, (HL+)", "DEC HL",
+    "INC L", "DEC L", "LD L, imm", "CPL",
+    "JR NC, imm", "LD SP, imm", "LDD (HL), A", "INC SP",
+    "INC (HL)", "DEC (HL)", "LD (HL), imm", "SCF",
+    "JR C, imm", "ADD HL, SP", "LDD A, (HL)", "DEC SP",
+    "INC A", "DEC A", "LD A, imm", "CCF",
+    "LD B, B", "LD B, C", "LD B, D", "LD B, E",
+    "LD B, H", "LD B, L", "LD B, (HL)", "LD B, A",
+    "LD C, B", "LD C, C", "LD C, D", "LD C, E",
+    "LD C, H", "LD C, L", "LD C, (HL)", "LD C, A",
+    "LD D, B", "LD D, C", "LD D, D", "LD D, E",
+    "LD D, H", "LD D, L", "LD D, (HL)", "LD D, A",
+    "LD E, B", "LD E, C", "LD E, D", "LD E, E",
+    "LD E, H", "LD E, L", "LD E, (HL)", "LD E, A",
+    "LD H, B", "LD H, C", "LD H, D", "LD H, E",
+    "LD H, H", "LD H, L", "LD H, (HL)", "LD H, A",
+    "LD L, B", "LD L, C", "LD L, D", "LD L, E",
+    "LD L, H", "LD L, L", "LD L, (HL)", "LD L, A",
+    "LD (HL), B", "LD (HL), C", "LD (HL), D", "LD (HL), E",
+    "LD (HL), H", "LD (HL), L", "HALT", "LD (HL), A",
+    "LD A, B", "LD A, C", "LD A, D", "LD A, E",
+    "LD A, H", "LD A, L", "LD A, (HL)", "LD A, A",
+    "ADD A, B", "ADD A, C", "ADD A, D", "ADD A, E",
+    "ADD A, H", "ADD A, L", "ADD A, (HL)", "ADD A, A",
+    "ADC A, B", "ADC A, C", "ADC A, D", "ADC A, E",
+    "ADC A, H", "ADC A, L", "ADC A, (HL)", "ADC A, A",
+    "SUB B", "SUB C", "SUB D", "SUB E",
+    "SUB H", "SUB L", "SUB (HL)", "SUB A",
+    "SBC A, B", "SBC A, C", "SBC A, D", "SBC A, E",
+    "SBC A, H", "SBC A, L", "SBC A, (HL)", "SBC A, A",
+    "AND B", "AND C", "AND D", "AND E",
+    "AND H", "AND L", "AND (HL)", "AND A",
+    "XOR B", "XOR C", "XOR D", "XOR E",
+    "XOR H", "XOR L", "XOR (HL)", "XOR A",
+    "OR B", "OR C", "OR D", "OR E",
+    "OR H", "OR L", "OR (HL)", "OR A",
+    "CP B", "CP C", "CP D", "CP E",
+    "CP H", "CP L", "CP (HL)", "CP A",
+    "RET NZ", "POP BC", "JP NZ, imm", "JP imm",
+    "CALL NZ, imm", "PUSH BC", "ADD A, imm", "RST 0x0000",
+    "RET Z", "RET", "JP Z, imm", "PREFIX CB",
+    "CALL Z, imm", "CALL imm", "ADC A, imm", "RST 0x0008",
+    "RET NC", "POP DE", "JP NC, imm", "-",
+    "CALL NC, imm", "PUSH DE", "SUB imm", "RST 0x0010",
+    "RET C", "RETI", "JP C, imm", "-",
+    "CALL C, imm", "-", "SBC A, imm", "RST 0x0018",
+    "LD (0xFF00+imm), A", "POP HL", "LD (C), A", "-",
+    "-", "PUSH HL", "AND imm", "RST 0x0020",
+    "ADD SP, imm", "JP HL", "LD (imm), A", "-",
+    "-", "-", "XOR imm", "RST 0x0028",
+    "LD A, (0xFF00+imm)", "POP AF", "LD A, (C)", "DI",
+    "-", "PUSH AF", "OR imm", "RST 0x0030",
+    "LD HL, SP+/-imm", "LD SP, HL", "LD A, (imm)", "EI",
+    "-", "-", "CP imm", "RST 0x0038",
+};
+
+static const char *const PROFILE_CB_NAMES[0x20] = {
+    "RLC", "RRC", "RL", "RR", "SLA", "SRA", "SWAP", "SRL",
+    "BIT 0,", "BIT 1,", "BIT 2,", "BIT 3,", "BIT 4,", "BIT 5,", "BIT 6,", "BIT 7,",
+    "RES 0,", "RES 1,", "RES 2,", "RES 3,", "RES 4,", "RES 5,", "RES 6,", "RES 7,",
+    "SET 0,", "SET 1,", "SET 2,", "SET 3,", "SET 4,", "SET 5,", "SET 6,", "SET 7,"
+};
+
+static const char *const PROFILE_CB_REGS[8] = {
+    "B", "C", "D", "E", "H", "L", "(HL)", "A"
+};
+
+
+/**
+ * Fills order[] with the indices 0-255 of values[], largest first.
+ */
+static void profile_rank(const uint64_t *values, uint8_t *order){
+    for(int i = 0; i < 0x100; i++){
+        int j = i;
+
+        while(j > 0 && values[order[j - 1]] < values[i]){
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+}
+
+static double profile_percent(uint64_t part, uint64_t total){
+    return total ? 100.0 * part / total : 0.0;
+}
+
+/**
+ * Prints the top entries of each table, ranked by emulated cycles for
+ * opcodes and by accesses for memory pages.
+ */
+void profile_print(const struct gb_s *gb, int top){
+    const struct gb_profile_s *p = &gb->profile;
+    uint8_t order[0x100];
+    uint64_t total_cycles = p->halt_cycles;
+    uint64_t total_ops = 0, total_cb_cycles = 0, total_reads = 0, total_writes = 0;
+
+    for(int i = 0; i < 0x100; i++){
+        total_cycles += p->op_cycles[i];
+        total_ops += p->op_count[i];
+        total_cb_cycles += p->cb_cycles[i];
+        total_reads += p->reads[i];
+        total_writes += p->writes[i];
+    }
+
+    printf("%llu instructions, %llu cycles, %.1f%% halted\n",
+            (unsigned long long)total_ops, (unsigned long long)total_cycles,
+            profile_percent(p->halt_cycles, total_cycles));
+
+    printf("\n  op  %-20s %12s %12s %6s\n", "instruction", "count", "cycles", "%");
+    profile_rank(p->op_cycles, order);
+    for(int i = 0; i < top && p->op_count[order[i]]; i++){
+        printf("  %02X  %-20s %12llu %12llu %5.1f%%\n", order[i], PROFILE_OP_NAMES[order[i]],
+                (unsigned long long)p->op_count[order[i]], (unsigned long long)p->op_cycles[order[i]],
+                profile_percent(p->op_cycles[order[i]], total_cycles));
+    }
+
+    printf("\nCB  op  %-16s %12s %12s %6s\n", "instruction", "count", "cycles", "% of CB");
+    profile_rank(p->cb_cycles, order);
+    for(int i = 0; i < top && p->cb_count[order[i]]; i++){
+        printf("    %02X  %-6s %-9s %12llu %12llu %5.1f%%\n", order[i],
+                PROFILE_CB_NAMES[order[i] >> 3], PROFILE_CB_REGS[order[i] & 7],
+                (unsigned long long)p->cb_count[order[i]], (unsigned long long)p->cb_cycles[order[i]],
+                profile_percent(p->cb_cycles[order[i]], total_cb_cycles));
+    }
+
+    printf("\n  page   %12s %6s\n", "reads", "%");
+    profile_rank(p->reads, order);
+    for(int i = 0; i < top && p->reads[order[i]]; i++){
+        printf("  %02X00   %12llu %5.1f%%\n", order[i], (unsigned long long)p->reads[order[i]],
+                profile_percent(p->reads[order[i]], total_reads));
+    }
+
+    printf("\n  page   %12s %6s\n", "writes", "%");
+    profile_rank(p->writes, order);
+    for(int i = 0; i < top && p->writes[order[i]]; i++){
+        printf("  %02X00   %12llu %5.1f%%\n", order[i], (unsigned long long)p->writes[order[i]],
+                profile_percent(p->writes[order[i]], total_writes));
+    }
+}
+
+#endif
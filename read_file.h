@@ -0,0 +1,43 @@
+/**
+ * Reading a whole file into memory, for the host tools (gbs_render,
+ * gbs_aot). Needs stdio.h and stdlib.h.
+ */
+
+#pragma once
+
+/**
+ * Reads the file name into a buffer from malloc, which the caller frees.
+ * Returns NULL, after printing why, if it cannot be opened, sized or held.
+ */
+static inline uint8_t *read_file(const char *name, uint32_t *size){
+    FILE *in = fopen(name, "rb");
+    uint8_t *data;
+    long length;
+
+    *size = 0;
+    if(!in){
+        perror(name);
+        return NULL;
+    }
+    if(fseek(in, 0, SEEK_END) || (length = ftell(in)) < 0){
+        perror(name);
+        fclose(in);
+        return NULL;
+    }
+    if(length >= UINT32_MAX){
+        fprintf(stderr, "%s: too large\n", name);
+        fclose(in);
+        return NULL;
+    }
+    rewind(in);
+    /* One byte more, so an empty file still gets a buffer */
+    data = malloc(length + 1);
+    if(!data){
+        fprintf(stderr, "%s: out of memory\n", name);
+        fclose(in);
+        return NULL;
+    }
+    *size = fread(data, 1, length, in);
+    fclose(in);
+    return data;
+}
@@ -0,0 +1,187 @@
+/**
+ * Single producer, single consumer queue of APU register writes.
+ *
+ * The producer (SM83 emulation) pushes every write to 0xFF10-0xFF3F as an
+ * event, with the time it was made at in the frame, followed by a frame
+ * marker once the frame is done. The consumer (mixer) takes one frame of
+ * events per 60 Hz tick, and applies each at the sample of its time. Head and
+ * tail are only ever written by one side each, so plain atomic loads/stores
+ * are enough; this matters on the M0+, which has no exclusive access
+ * instructions.
+ *
+ * A frame can have more writes than the queue holds. The producer then
+ * stops partway through it while there is no room (reg_queue_run_room), and
+ * the consumer, seeing the queue full without a whole frame in it
+ * (reg_queue_stalled), takes the writes that are there early.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+
+#define REG_QUEUE_SIZE          0x800   /* Events, must be a power of 2 */
+#define REG_QUEUE_MASK          (REG_QUEUE_SIZE - 1)
+#define REG_QUEUE_FRAMES_AHEAD  3       /* Frames the producer may run ahead */
+#define REG_QUEUE_FRAME_RESERVE 0x100   /* Free events needed to start a frame */
+#define REG_QUEUE_RUN_RESERVE   0x40    /* Free events needed to go on with one, more than a run of blocks writes */
+
+/* Events are (time << 16) | (reg << 8) | val, time in M-cycles (4 T-cycles)
+ * from the start of the frame. Register numbers below 0x10 are markers. */
+#define REG_EVENT_FRAME     0x00    /* End of one 60 Hz frame */
+#define REG_EVENT_RESET     0x01    /* Song (re)started, val = request number */
+
+#define REG_EVENT_TIME(e)   ((e) >> 16)
+#define REG_EVENT_REG(e)    (((e) >> 8) & 0xFF)
+#define REG_EVENT_VAL(e)    ((e) & 0xFF)
+
+/* What to do while waiting on the other side. */
+#ifndef REG_QUEUE_IDLE
+    #define REG_QUEUE_IDLE() tight_loop_contents()
+#endif
+
+struct reg_queue_s
+{
+    uint32_t events[REG_QUEUE_SIZE];
+
+    /* Written by the producer only. */
+    _Atomic uint32_t head;
+    _Atomic uint32_t frames_produced;
+
+    /* Written by the consumer only. */
+    _Atomic uint32_t tail;
+    _Atomic uint32_t frames_consumed;
+    _Atomic uint32_t song_seq;  /* Bumped for every song request */
+    _Atomic uint8_t song;
+};
+
+
+void reg_queue_init(struct reg_queue_s *q){
+    atomic_store(&q->head, 0);
+    atomic_store(&q->frames_produced, 0);
+    atomic_store(&q->tail, 0);
+    atomic_store(&q->frames_consumed, 0);
+    atomic_store(&q->song_seq, 0);
+    atomic_store(&q->song, 0);
+}
+
+/**
+ * Producer: queue one event, waiting for the consumer if the queue is full.
+ */
+void reg_queue_push(struct reg_queue_s *q, uint16_t time, uint8_t reg, uint8_t val){
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    while(head - atomic_load_explicit(&q->tail, memory_order_acquire) >= REG_QUEUE_SIZE)
+        REG_QUEUE_IDLE();
+
+    q->events[head & REG_QUEUE_MASK] = ((uint32_t)time << 16) | (reg << 8) | val;
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+}
+
+/**
+ * Producer: close the current frame.
+ */
+void reg_queue_end_frame(struct reg_queue_s *q){
+    reg_queue_push(q, 0, REG_EVENT_FRAME, 0);
+    atomic_store_explicit(&q->frames_produced,
+            atomic_load_explicit(&q->frames_produced, memory_order_relaxed) + 1,
+            memory_order_release);
+}
+
+/**
+ * Producer: true if there is room to emulate another frame.
+ */
+bool reg_queue_has_room(struct reg_queue_s *q){
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if(atomic_load_explicit(&q->frames_produced, memory_order_relaxed)
+            - atomic_load_explicit(&q->frames_consumed, memory_order_acquire) >= REG_QUEUE_FRAMES_AHEAD)
+        return false;
+
+    return head - atomic_load_explicit(&q->tail, memory_order_acquire) <= REG_QUEUE_SIZE - REG_QUEUE_FRAME_RESERVE;
+}
+
+/**
+ * Producer: true if there is room to go on with the frame started, for the
+ * writes of one more instruction or run of blocks, and the frame marker.
+ */
+bool reg_queue_run_room(struct reg_queue_s *q){
+    return atomic_load_explicit(&q->head, memory_order_relaxed)
+            - atomic_load_explicit(&q->tail, memory_order_acquire) <= REG_QUEUE_SIZE - REG_QUEUE_RUN_RESERVE;
+}
+
+/**
+ * Consumer: true if at least one complete frame is queued.
+ */
+bool reg_queue_frame_ready(struct reg_queue_s *q){
+    return atomic_load_explicit(&q->frames_produced, memory_order_acquire)
+            != atomic_load_explicit(&q->frames_consumed, memory_order_relaxed);
+}
+
+/**
+ * Consumer: how many complete frames are queued.
+ */
+uint32_t reg_queue_frames_ready(struct reg_queue_s *q){
+    return atomic_load_explicit(&q->frames_produced, memory_order_acquire)
+            - atomic_load_explicit(&q->frames_consumed, memory_order_relaxed);
+}
+
+/**
+ * Consumer: true if there is an event to pop.
+ */
+bool reg_queue_event_ready(struct reg_queue_s *q){
+    return atomic_load_explicit(&q->head, memory_order_acquire)
+            != atomic_load_explicit(&q->tail, memory_order_relaxed);
+}
+
+/**
+ * Consumer: true if the producer has stopped partway through a frame for
+ * room, and will not finish it until some of it is popped.
+ */
+bool reg_queue_stalled(struct reg_queue_s *q){
+    return !reg_queue_frame_ready(q)
+            && atomic_load_explicit(&q->head, memory_order_acquire)
+            - atomic_load_explicit(&q->tail, memory_order_relaxed) > REG_QUEUE_SIZE - REG_QUEUE_RUN_RESERVE;
+}
+
+/**
+ * Consumer: the next event, left queued. There must be one.
+ */
+uint32_t reg_queue_peek(struct reg_queue_s *q){
+    return q->events[atomic_load_explicit(&q->tail, memory_order_relaxed) & REG_QUEUE_MASK];
+}
+
+/**
+ * Consumer: take the next event, waiting for the producer if there is none.
+ */
+uint32_t reg_queue_pop(struct reg_queue_s *q){
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    uint32_t event;
+
+    while(atomic_load_explicit(&q->head, memory_order_acquire) == tail)
+        REG_QUEUE_IDLE();
+
+    event = q->events[tail & REG_QUEUE_MASK];
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return event;
+}
+
+/**
+ * Consumer: mark the frame just popped as done.
+ */
+void reg_queue_frame_done(struct reg_queue_s *q){
+    atomic_store_explicit(&q->frames_consumed,
+            atomic_load_explicit(&q->frames_consumed, memory_order_relaxed) + 1,
+            memory_order_release);
+}
+
+/**
+ * Consumer: ask the producer to (re)start a song. Returns the request number
+ * that the matching REG_EVENT_RESET will carry in its low 8 bits.
+ */
+uint32_t reg_queue_request_song(struct reg_queue_s *q, uint8_t song){
+    uint32_t seq = atomic_load_explicit(&q->song_seq, memory_order_relaxed) + 1;
+
+    atomic_store_explicit(&q->song, song, memory_order_relaxed);
+    atomic_store_explicit(&q->song_seq, seq, memory_order_release);
+    return seq;
+}
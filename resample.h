@@ -0,0 +1,121 @@
+/**
+ * Polyphase resampler from the synthesis rate (SAMPLE_RATE) to the output
+ * rate, which can be changed at runtime.
+ *
+ * Each output sample is a RESAMPLE_TAPS tap FIR over the input, using the
+ * coefficient set of the nearest of RESAMPLE_PHASES fractional positions.
+ * The coefficients are a Blackman windowed sinc, cut off below the lower of
+ * the two Nyquist frequencies. They are worked out once by resample_init;
+ * filtering is all fixed point, with 14 bit coefficients. At the synthesis
+ * rate the samples are passed through untouched.
+ */
+
+#pragma once
+
+#include <math.h>
+
+#define RESAMPLE_TAPS       16
+#define RESAMPLE_PHASE_BITS 5
+#define RESAMPLE_PHASES     (1 << RESAMPLE_PHASE_BITS)
+#define RESAMPLE_SHIFT      14
+#define RESAMPLE_MIN_RATE   8000
+#define RESAMPLE_MAX_RATE   96000
+/* Most output samples one block of input can give */
+#define RESAMPLE_MAX_OUT    (MIX_BLOCK * RESAMPLE_MAX_RATE / SAMPLE_RATE + 2)
+
+struct resample_s
+{
+    uint32_t rate;      /* Output rate in Hz */
+    uint32_t step;      /* Input samples per output sample, 16.16 */
+    uint32_t pos;       /* First tap of the next output sample in hist, 16.16 */
+    int16_t coef[RESAMPLE_PHASES][RESAMPLE_TAPS];
+    int8_t hist[(RESAMPLE_TAPS - 1 + MIX_BLOCK) * 2];  /* Stereo, the end of the last block then this one */
+};
+
+
+/**
+ * Clears the input history, for the start of a song.
+ */
+void resample_reset(struct resample_s *r){
+    for(uint32_t i = 0; i < sizeof(r->hist); i++) r->hist[i] = 0;
+    r->pos = 0;
+}
+
+/**
+ * Sets the output rate in Hz, clamped to RESAMPLE_MIN_RATE-RESAMPLE_MAX_RATE.
+ * Returns the rate used.
+ */
+uint32_t resample_init(struct resample_s *r, uint32_t rate){
+    const double pi = 3.14159265358979323846;
+    double cutoff, x, w, c[RESAMPLE_TAPS];
+
+    if(rate < RESAMPLE_MIN_RATE) rate = RESAMPLE_MIN_RATE;
+    if(rate > RESAMPLE_MAX_RATE) rate = RESAMPLE_MAX_RATE;
+    r->rate = rate;
+    r->step = ((uint64_t)SAMPLE_RATE << 16) / rate;
+
+    // Cutoff in cycles per input sample, a little under Nyquist to leave room for the transition band
+    cutoff = 0.45 * (rate < SAMPLE_RATE ? (double)rate / SAMPLE_RATE : 1.0);
+    for(int p = 0; p < RESAMPLE_PHASES; p++){
+        double sum = 0;
+        int32_t total = 0, center = RESAMPLE_TAPS / 2 - 1;
+
+        for(int k = 0; k < RESAMPLE_TAPS; k++){
+            x = k - (RESAMPLE_TAPS / 2 - 1) - (double)p / RESAMPLE_PHASES;
+            w = 0.42 + 0.5 * cos(pi * x / (RESAMPLE_TAPS / 2)) + 0.08 * cos(2 * pi * x / (RESAMPLE_TAPS / 2));
+            c[k] = (x == 0 ? 2 * cutoff : sin(2 * pi * cutoff * x) / (pi * x)) * w;
+            sum += c[k];
+        }
+        // Each phase sums to exactly 1, so there is no DC ripple between phases
+        for(int k = 0; k < RESAMPLE_TAPS; k++){
+            r->coef[p][k] = lround(c[k] / sum * (1 << RESAMPLE_SHIFT));
+            total += r->coef[p][k];
+        }
+        r->coef[p][center] += (1 << RESAMPLE_SHIFT) - total;
+    }
+
+    resample_reset(r);
+    return rate;
+}
+
+
+static inline int8_t resample_clamp(int32_t x){
+    x = (x + (1 << (RESAMPLE_SHIFT - 1))) >> RESAMPLE_SHIFT;
+    return x > 127 ? 127 : (x < -128 ? -128 : x);
+}
+
+/**
+ * Resamples frames (at most MIX_BLOCK) of interleaved stereo input into
+ * out, which must have room for RESAMPLE_MAX_OUT stereo samples. Returns the
+ * number of stereo samples written.
+ */
+uint32_t resample_block(struct resample_s *r, const int8_t *in, uint32_t frames, int8_t *out){
+    int8_t *hist = r->hist;
+    uint32_t n = 0;
+
+    if(r->rate == SAMPLE_RATE){
+        for(uint32_t i = 0; i < frames * 2; i++) out[i] = in[i];
+        return frames;
+    }
+
+    for(uint32_t i = 0; i < frames * 2; i++) hist[(RESAMPLE_TAPS - 1) * 2 + i] = in[i];
+
+    // Output samples whose taps all fall within the history so far
+    for(; r->pos < (frames << 16); r->pos += r->step){
+        const int16_t *c = r->coef[(r->pos >> (16 - RESAMPLE_PHASE_BITS)) & (RESAMPLE_PHASES - 1)];
+        const int8_t *x = &hist[(r->pos >> 16) * 2];
+        int32_t left = 0, right = 0;
+
+        for(int k = 0; k < RESAMPLE_TAPS; k++){
+            left += x[k * 2] * c[k];
+            right += x[k * 2 + 1] * c[k];
+        }
+        out[n * 2] = resample_clamp(left);
+        out[n * 2 + 1] = resample_clamp(right);
+        n++;
+    }
+    r->pos -= frames << 16;
+
+    for(uint32_t i = 0; i < (RESAMPLE_TAPS - 1) * 2; i++) hist[i] = hist[frames * 2 + i];
+    return n;
+}
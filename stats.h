@@ -0,0 +1,117 @@
+/**
+ * Performance counters, to tell apart the ways a track can glitch: the
+ * emulated frame took too long, the mixer was too slow, or the output
+ * buffer ran dry.
+ *
+ * Every field has exactly one writer (core 1 for the producer fields,
+ * core 0 for the rest), so no locking is needed: the consumer does not clear
+ * the producer's fields itself, it asks for them to be cleared with
+ * resetRequest and the producer does it before its next frame. Reads from
+ * the other core may be a little stale, which is fine for telemetry.
+ */
+
+#pragma once
+
+/* Free running tick counter, and the mask for differences between two
+ * readings. Defaults to the Cortex-M0+ SysTick, counting down at the system
+ * clock (SYS_CLOCK_KHZ); it must have been started on each core with
+ * stats_start(). */
+#ifndef STATS_NOW
+    #define STATS_SYSTICK
+    #define STATS_NOW()         (0xFFFFFF - systick_hw->cvr)
+    #define STATS_TICK_MASK     0xFFFFFF
+    #define STATS_TICK_HZ       ((uint32_t)SYS_CLOCK_KHZ * 1000)
+#endif
+
+struct stats_s
+{
+    /* Producer */
+    uint32_t frames;            /* Frames emulated */
+    uint64_t frameTicks;        /* Time spent in gb_run_frame, summed */
+    uint32_t frameTicksMax;     /* Worst single frame */
+    uint32_t instructions;      /* Instructions executed, summed */
+    uint32_t instructionsMax;   /* Most instructions in one 60 Hz frame */
+    uint32_t resetDone;         /* Last resetRequest the fields were cleared for */
+
+    /* Consumer */
+    volatile uint32_t resetRequest; /* Bumped to have the producer clear its fields */
+    uint32_t mixBlocks;         /* Blocks of MIX_BLOCK samples */
+    uint64_t mixTicks;          /* Time spent in the mixer, summed */
+    uint32_t mixTicksMax;       /* Worst single block */
+    uint32_t bufferMin;         /* Lowest output buffer fill seen, in bytes */
+    uint32_t underruns;         /* Output buffer ran dry */
+    uint32_t lateFrames;        /* Producer had no frame ready in time */
+};
+
+
+#ifdef STATS_SYSTICK
+/**
+ * Starts SysTick on the calling core, free running from the processor clock.
+ */
+void stats_start(void){
+    systick_hw->rvr = 0xFFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+}
+#endif
+
+/**
+ * Clears the sums and maxima, but not the running totals of underruns and
+ * late frames. Called by the consumer: the producer's fields are cleared by
+ * the producer, before it records its next frame.
+ */
+void stats_reset(struct stats_s *stats){
+    stats->resetRequest++;
+    stats->mixBlocks = 0;
+    stats->mixTicks = 0;
+    stats->mixTicksMax = 0;
+    stats->bufferMin = UINT32_MAX;
+}
+
+/**
+ * Producer: record one emulated frame.
+ */
+void stats_frame(struct stats_s *stats, uint32_t ticks, uint32_t instructions){
+    if(stats->resetDone != stats->resetRequest){
+        stats->resetDone = stats->resetRequest;
+        stats->frames = 0;
+        stats->frameTicks = 0;
+        stats->frameTicksMax = 0;
+        stats->instructions = 0;
+        stats->instructionsMax = 0;
+    }
+    stats->frames++;
+    stats->frameTicks += ticks;
+    if(ticks > stats->frameTicksMax) stats->frameTicksMax = ticks;
+    stats->instructions += instructions;
+    if(instructions > stats->instructionsMax) stats->instructionsMax = instructions;
+}
+
+/**
+ * Consumer: record one mixed block.
+ */
+void stats_mix(struct stats_s *stats, uint32_t ticks){
+    stats->mixBlocks++;
+    stats->mixTicks += ticks;
+    if(ticks > stats->mixTicksMax) stats->mixTicksMax = ticks;
+}
+
+static uint32_t stats_us(uint64_t ticks){
+    return ticks * 1000000 / STATS_TICK_HZ;
+}
+
+/**
+ * Prints the counters on one line, times in microseconds.
+ */
+void stats_print(const struct stats_s *stats){
+    uint32_t frames = stats->frames ? stats->frames : 1;
+    uint32_t blocks = stats->mixBlocks ? stats->mixBlocks : 1;
+
+    printf("frames %lu cpu %lu/%lu us instr %lu/%lu mix %lu/%lu us buffer min %ld underruns %lu late %lu\n",
+            (unsigned long)stats->frames,
+            (unsigned long)stats_us(stats->frameTicks / frames), (unsigned long)stats_us(stats->frameTicksMax),
+            (unsigned long)(stats->instructions / frames), (unsigned long)stats->instructionsMax,
+            (unsigned long)stats_us(stats->mixTicks / blocks), (unsigned long)stats_us(stats->mixTicksMax),
+            stats->bufferMin == UINT32_MAX ? -1L : (long)stats->bufferMin,
+            (unsigned long)stats->underruns, (unsigned long)stats->lateFrames);
+}
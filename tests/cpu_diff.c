@@ -0,0 +1,129 @@
+/*
+ * Differential test of the CPU core. It is built three times (see
+ * tests/CMakeLists.txt): with the block engine, with the decode cache only,
+ * and stepping every instruction through __gb_execute. Each build runs the
+ * synthetic GBS files of synth.h, hashing the CPU state and memory after
+ * every frame and every sound register write with its time, and prints a
+ * hash per song; the three must print the same.
+ *
+ * Usage: cpu_diff [-n programs] [-f frames]
+ *
+ * -n sets how many random programs are run (200 by default), half of them
+ * with bank switches, after the drivers. -f sets how many frames each song
+ * runs for (60 by default).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define SAMPLE_RATE 44100
+#define MIX_BLOCK 64
+#define REG_QUEUE_IDLE() do{}while(0)
+
+#define STATS_NOW() 0
+#define STATS_TICK_MASK 0xFFFFFFFF
+#define STATS_TICK_HZ 1000000000
+
+#include "tables.h"
+#include "stats.h"
+#include "reg_queue.h"
+#include "clock.h"
+#include "mix.h"
+#include "apu.h"
+#include "peanut_gb.h"
+#include "synth.h"
+
+static struct synth_s synth;
+static struct gb_s gb;
+static struct reg_queue_s queue;
+static struct stats_s stats;
+
+// FNV-1a, 64 bit
+#define HASH_INIT 0xCBF29CE484222325ull
+
+static uint64_t hash_add(uint64_t hash, uint32_t v){
+	for(int i = 0; i < 4; i++, v >>= 8) hash = (hash ^ (v & 0xFF)) * 0x100000001B3ull;
+	return hash;
+}
+
+// Pops what the producer queued, returning the frames it finished
+static uint32_t drain(uint64_t *hash){
+	uint32_t frames = 0;
+
+	while(reg_queue_event_ready(&queue)){
+		uint32_t event = reg_queue_pop(&queue);
+
+		*hash = hash_add(*hash, event);
+		if(REG_EVENT_REG(event) == REG_EVENT_FRAME){
+			reg_queue_frame_done(&queue);
+			frames++;
+		}
+	}
+	return frames;
+}
+
+static uint64_t hash_state(uint64_t hash){
+	const struct cpu_registers_s *r = &gb.cpu_reg;
+
+	hash = hash_add(hash, r->a | __gb_get_f(r) << 8 | r->bc << 16);
+	hash = hash_add(hash, r->de | r->hl << 16);
+	hash = hash_add(hash, r->sp | r->pc << 16);
+	hash = hash_add(hash, gb.gb_reg.IF | gb.gb_reg.IE << 8 | gb.gb_reg.TIMA << 16 | gb.gb_reg.LY << 24);
+	hash = hash_add(hash, gb.gb_ime | gb.gb_halt << 8 | gb.selected_rom_bank << 16);
+	for(int i = 0; i < WRAM_SIZE; i++) hash = hash_add(hash, gb.wram[i]);
+	for(int i = 0; i < HRAM_SIZE; i++) hash = hash_add(hash, gb.hram[i]);
+	return hash;
+}
+
+// Runs every song of the file for frames, printing a hash of each
+static bool run(const char *name, uint32_t size, uint32_t frames){
+	uint8_t songs;
+
+	if(!size || !(songs = gb_load_gbs(&gb, synth.gbs, size))){
+		fprintf(stderr, "%s: not a GBS file\n", name);
+		return false;
+	}
+	reg_queue_init(&queue);
+	gb.apu_queue = &queue;
+	gb.stats = &stats;
+
+	for(uint8_t song = 0; song < songs; song++){
+		uint64_t hash = HASH_INIT;
+		uint32_t done = 0;
+
+		reg_queue_request_song(&queue, song);
+		while(done < frames){
+			gb_produce(&gb);
+			done += drain(&hash);
+			if(!gb.frame_open) hash = hash_state(hash);
+		}
+		printf("%s %u %016llx\n", name, song + 1, (unsigned long long)hash);
+	}
+	return true;
+}
+
+int main(int argc, char **argv){
+	uint32_t programs = 200, frames = 60;
+	char name[32];
+	bool ok = true;
+
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) programs = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-f") && i + 1 < argc) frames = atoi(argv[++i]);
+		else{
+			fprintf(stderr, "Usage: %s [-n programs] [-f frames]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	ok &= run("driver", synth_driver(&synth), frames);
+	ok &= run("idle", synth_idle(&synth), frames);
+	ok &= run("banks", synth_banks(&synth), frames);
+	for(uint32_t seed = 1; seed <= programs; seed++){
+		snprintf(name, sizeof(name), "random-%u", seed);
+		ok &= run(name, synth_random(&synth, seed, seed > programs / 2), frames);
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+# Runs the cpu_diff builds given in CPUS (comma separated) and fails, naming
+# the first song that differs, unless they all print the same.
+
+string(REPLACE "," ";" CPUS "${CPUS}")
+list(GET CPUS 0 reference)
+foreach(cpu IN LISTS CPUS)
+    execute_process(COMMAND ${cpu} OUTPUT_VARIABLE output RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${cpu} failed: ${result}")
+    endif()
+    if(cpu STREQUAL reference)
+        set(expected "${output}")
+    elseif(NOT output STREQUAL expected)
+        string(REPLACE "\n" ";" lines "${output}")
+        string(REPLACE "\n" ";" expected_lines "${expected}")
+        list(LENGTH expected_lines count)
+        set(i 0)
+        foreach(line IN LISTS lines)
+            if(i EQUAL count)
+                message(FATAL_ERROR "${cpu} prints more than ${reference}")
+            endif()
+            list(GET expected_lines ${i} expected_line)
+            if(NOT line STREQUAL expected_line)
+                message(FATAL_ERROR "${cpu} differs from ${reference}:\n  ${line}\n  ${expected_line}")
+            endif()
+            math(EXPR i "${i} + 1")
+        endforeach()
+        message(FATAL_ERROR "${cpu} prints less than ${reference}")
+    endif()
+endforeach()
+list(LENGTH CPUS count)
+message(STATUS "${count} builds agree")
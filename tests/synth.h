@@ -0,0 +1,358 @@
+/**
+ * Synthetic GBS files for the tests, so that the CPU core and the mixer can
+ * be checked without GBS rips, which cannot be checked in. The drivers are
+ * homebrew, put together byte by byte with the few helpers below; the
+ * random programs are for cpu_diff.c, which runs them on every CPU path.
+ */
+
+#pragma once
+
+#define SYNTH_LOAD      0x400
+#define SYNTH_SIZE      (0x70 + 3 * 0x4000 - SYNTH_LOAD)    /* Header and banks 0 to 2 */
+#define SYNTH_LABELS    32
+#define SYNTH_FIXES     64
+
+struct synth_fix_s
+{
+    uint32_t pos;       /* Of the byte(s) to fill in */
+    uint16_t next;      /* Address of the instruction after, for JR */
+    uint8_t label;
+    bool rel;
+};
+
+struct synth_s
+{
+    uint8_t gbs[SYNTH_SIZE];
+    uint32_t size;      /* Bytes used */
+    uint32_t pos;       /* Where the next byte goes */
+    uint16_t addr;      /* Address it is at */
+    uint16_t label[SYNTH_LABELS];
+    struct synth_fix_s fix[SYNTH_FIXES];
+    uint32_t fixes;
+};
+
+/* Appends the bytes given. */
+#define SYNTH(s, ...) synth_bytes((s), (const uint8_t[]){__VA_ARGS__}, sizeof((const uint8_t[]){__VA_ARGS__}))
+
+
+/**
+ * Starts a file: the header, with the code loaded at SYNTH_LOAD and the
+ * stack at 0xDFF0. tac is 0 for a play routine called on VBlank.
+ */
+void synth_start(struct synth_s *s, uint8_t songs, uint8_t tma, uint8_t tac){
+    memset(s, 0, sizeof(*s));
+    memcpy(s->gbs, "GBS\x01", 4);
+    s->gbs[0x04] = songs;
+    s->gbs[0x05] = 1;
+    s->gbs[0x06] = SYNTH_LOAD & 0xFF;
+    s->gbs[0x07] = SYNTH_LOAD >> 8;
+    s->gbs[0x0C] = 0xF0;
+    s->gbs[0x0D] = 0xDF;
+    s->gbs[0x0E] = tma;
+    s->gbs[0x0F] = tac;
+    s->size = 0x70;
+    s->pos = 0x70;
+    s->addr = SYNTH_LOAD;
+}
+
+/**
+ * Goes on at addr, in ROM bank bank if addr is 0x4000 or above.
+ */
+void synth_org(struct synth_s *s, uint8_t bank, uint16_t addr){
+    s->addr = addr;
+    s->pos = 0x70 + (addr < 0x4000 ? addr : bank * 0x4000 + (addr - 0x4000)) - SYNTH_LOAD;
+    if(s->pos > s->size) s->size = s->pos;
+}
+
+void synth_bytes(struct synth_s *s, const uint8_t *bytes, uint32_t count){
+    memcpy(&s->gbs[s->pos], bytes, count);
+    s->pos += count;
+    s->addr += count;
+    if(s->pos > s->size) s->size = s->pos;
+}
+
+/**
+ * Puts label n at the next byte.
+ */
+void synth_label(struct synth_s *s, uint8_t n){
+    s->label[n] = s->addr;
+}
+
+/**
+ * Appends op with label n as its operand: relative (JR) or absolute.
+ */
+static void synth_ref(struct synth_s *s, uint8_t op, uint8_t n, bool rel){
+    struct synth_fix_s *f = &s->fix[s->fixes++];
+
+    f->pos = s->pos + 1;
+    f->next = s->addr + (rel ? 2 : 3);
+    f->label = n;
+    f->rel = rel;
+    if(rel) SYNTH(s, op, 0);
+    else SYNTH(s, op, 0, 0);
+}
+
+void synth_jr(struct synth_s *s, uint8_t op, uint8_t n){
+    synth_ref(s, op, n, true);
+}
+
+void synth_abs(struct synth_s *s, uint8_t op, uint8_t n){
+    synth_ref(s, op, n, false);
+}
+
+/**
+ * Fills in the labels and the init and play addresses. Returns the size of
+ * the file, or 0 if a JR does not reach its label.
+ */
+uint32_t synth_end(struct synth_s *s, uint16_t init, uint16_t play){
+    s->gbs[0x08] = init & 0xFF;
+    s->gbs[0x09] = init >> 8;
+    s->gbs[0x0A] = play & 0xFF;
+    s->gbs[0x0B] = play >> 8;
+
+    for(uint32_t i = 0; i < s->fixes; i++){
+        const struct synth_fix_s *f = &s->fix[i];
+        int32_t d = s->label[f->label] - f->next;
+
+        if(!f->rel){
+            s->gbs[f->pos] = s->label[f->label] & 0xFF;
+            s->gbs[f->pos + 1] = s->label[f->label] >> 8;
+        }else if(d < -128 || d > 127){
+            return 0;
+        }else{
+            s->gbs[f->pos] = d & 0xFF;
+        }
+    }
+    return s->size;
+}
+
+
+static uint32_t synth_rnd(uint32_t *r){
+    *r ^= *r << 13;
+    *r ^= *r >> 17;
+    *r ^= *r << 5;
+    return *r;
+}
+
+/**
+ * A music driver of the usual kind, played on VBlank: four note streams,
+ * each with its delay, vibrato and an envelope worked out with a software
+ * multiply, sound register writes through LDH (C), and a checksum pass over
+ * its state.
+ */
+uint32_t synth_driver(struct synth_s *s){
+    enum { INIT, INITLOOP, CLR, PLAY, OUTER, CHLOOP, NOTEND, ISNOTE, TICK, UP, MUL, NC, SKIPWR, SUM, FREQS, SONG };
+    uint32_t r = 1;
+
+    synth_start(s, 1, 0, 0);
+    // Channel state at C000 + 16 * c: delay, pointer, note, vibrato phase, envelope, frequency
+    synth_label(s, INIT);
+    SYNTH(s, 0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25);
+    SYNTH(s, 0x21, 0x00, 0xC0, 0x0E, 0x00);                 // ld hl,C000; ld c,0
+    synth_label(s, INITLOOP);
+    SYNTH(s, 0x3E, 0x01, 0x22);                             // ld a,1; ld (hl+),a
+    SYNTH(s, 0x79, 0x87, 0x87, 0x87, 0x87);                 // ld a,c; add a,a x4
+    synth_abs(s, 0x11, SONG);                               // ld de,song
+    SYNTH(s, 0x83, 0x22, 0x7A, 0xCE, 0x00, 0x22);           // pointer = song + c * 16
+    SYNTH(s, 0xAF, 0x06, 13);                               // xor a; ld b,13
+    synth_label(s, CLR);
+    SYNTH(s, 0x22, 0x05);                                   // ld (hl+),a; dec b
+    synth_jr(s, 0x20, CLR);
+    SYNTH(s, 0x0C, 0x79, 0xFE, 0x04);                       // inc c; ld a,c; cp 4
+    synth_jr(s, 0x20, INITLOOP);
+    SYNTH(s, 0xC9);
+
+    synth_org(s, 0, 0x480);
+    synth_label(s, PLAY);
+    SYNTH(s, 0x3E, 0x10, 0xE0, 0x81);                       // ld a,16; ldh (81),a
+    synth_label(s, OUTER);
+    SYNTH(s, 0x21, 0x00, 0xC0, 0x0E, 0x00);                 // ld hl,C000; ld c,0
+    synth_label(s, CHLOOP);
+    SYNTH(s, 0xE5, 0xC5, 0x35);                             // push hl; push bc; dec (hl)
+    synth_jr(s, 0x20, TICK);
+    SYNTH(s, 0x23, 0x5E, 0x23, 0x56, 0x1A, 0x13);           // de = pointer; ld a,(de); inc de
+    SYNTH(s, 0xFE, 0xFF);                                   // cp FF
+    synth_jr(s, 0x20, NOTEND);
+    SYNTH(s, 0x1A, 0x5F, 0x13, 0x1A, 0x57, 0x1A);           // follow the loop pointer
+    SYNTH(s, 0x7B, 0xE6, 0xF0, 0x5F, 0x1A, 0x13);           // back to the start of the stream
+    synth_label(s, NOTEND);
+    SYNTH(s, 0x72, 0x2B, 0x73, 0x2B);                       // store the pointer back
+    SYNTH(s, 0xCB, 0x7F);                                   // bit 7,a
+    synth_jr(s, 0x28, ISNOTE);
+    SYNTH(s, 0xE6, 0x0F, 0x3C, 0x77);                       // a rest: delay = a & F + 1
+    synth_jr(s, 0x18, TICK);
+    synth_label(s, ISNOTE);
+    SYNTH(s, 0x47, 0xE6, 0x07, 0xC6, 0x03, 0x77);           // delay = a & 7 + 3
+    SYNTH(s, 0x78, 0xCB, 0x3F, 0xCB, 0x3F, 0xCB, 0x3F, 0xE6, 0x0F);
+    SYNTH(s, 0x23, 0x23, 0x23, 0x77);                       // note
+    SYNTH(s, 0x87, 0x5F, 0x16, 0x00, 0xE5);                 // de = note * 2; push hl
+    synth_abs(s, 0x21, FREQS);                              // ld hl,freqs
+    SYNTH(s, 0x19, 0x2A, 0x66, 0x6F, 0x44, 0x4D, 0xE1);     // bc = freqs[note]; pop hl
+    SYNTH(s, 0x23, 0x36, 0x00, 0x23, 0x36, 0xF0);           // vibrato 0, envelope F0
+    SYNTH(s, 0x23, 0x71, 0x23, 0x70);                       // frequency = bc
+    synth_label(s, TICK);
+    SYNTH(s, 0xC1, 0xE1, 0xE5, 0xC5);                       // pop bc; pop hl; push hl; push bc
+    SYNTH(s, 0x7D, 0xC6, 0x04, 0x6F);                       // hl = vibrato phase
+    SYNTH(s, 0x34, 0x7E, 0xE6, 0x1F, 0xCB, 0x67);           // inc (hl); triangle of it
+    synth_jr(s, 0x28, UP);
+    SYNTH(s, 0x2F, 0xE6, 0x0F);
+    synth_label(s, UP);
+    SYNTH(s, 0xE6, 0x0F, 0xCB, 0x3F, 0x57);                 // d = offset
+    SYNTH(s, 0x23, 0x7E, 0x5F, 0x06, 0x0F, 0xAF, 0x0E, 0x00);   // envelope * 15 / 16
+    synth_label(s, MUL);
+    SYNTH(s, 0x83);
+    synth_jr(s, 0x30, NC);
+    SYNTH(s, 0x0C);
+    synth_label(s, NC);
+    SYNTH(s, 0x05);
+    synth_jr(s, 0x20, MUL);
+    SYNTH(s, 0x79, 0xCB, 0x27, 0xCB, 0x27, 0xCB, 0x27, 0xCB, 0x27, 0x77);
+    SYNTH(s, 0x23, 0x5E, 0x23, 0x7E);                       // e, a = frequency
+    SYNTH(s, 0x47, 0x7B, 0x82, 0x5F, 0x78, 0xCE, 0x00, 0x57);   // de = frequency + offset
+    SYNTH(s, 0xC1, 0xC5, 0x79, 0xFE, 0x03);                 // c = channel; cp 3
+    synth_jr(s, 0x28, SKIPWR);
+    SYNTH(s, 0x79, 0x87, 0x87, 0x81, 0xC6, 0x12, 0x4F);     // c = NRx2
+    SYNTH(s, 0x2B, 0x2B, 0x7E, 0xE6, 0xF0, 0xE2, 0x0C);     // envelope to NRx2
+    SYNTH(s, 0x7B, 0xE2, 0x0C, 0x7A, 0xE6, 0x07, 0xE2);     // frequency to NRx3 and NRx4
+    synth_label(s, SKIPWR);
+    SYNTH(s, 0xC1, 0xE1, 0x7D, 0xC6, 0x10, 0x6F);           // pop bc; pop hl; hl += 16
+    SYNTH(s, 0x0C, 0x79, 0xFE, 0x04);
+    synth_abs(s, 0xC2, CHLOOP);
+    SYNTH(s, 0x21, 0x00, 0xC0, 0x06, 0x40, 0xAF);           // checksum 64 bytes of state
+    synth_label(s, SUM);
+    SYNTH(s, 0xAE, 0x07, 0x23, 0x05);
+    synth_jr(s, 0x20, SUM);
+    SYNTH(s, 0xE0, 0x80, 0xF0, 0x81, 0x3D, 0xE0, 0x81);     // ldh (80),a; 16 times round
+    synth_abs(s, 0xC2, OUTER);
+    SYNTH(s, 0xC9);
+
+    synth_label(s, FREQS);
+    for(int i = 0; i < 16; i++) SYNTH(s, (0x600 + i * 61) & 0xFF, (0x600 + i * 61) >> 8);
+    synth_label(s, SONG);
+    for(int c = 0; c < 4; c++){
+        for(int i = 0; i < 15; i++){
+            uint32_t n = synth_rnd(&r);
+            SYNTH(s, (n & 1) ? ((n >> 8) | 0x80) & 0xFE : (n >> 8) & 0x0F);
+        }
+        SYNTH(s, 0xFF);
+    }
+    for(int i = 0; i < 16; i++) SYNTH(s, 0);
+    return synth_end(s, s->label[INIT], s->label[PLAY]);
+}
+
+/**
+ * Three songs driven by the timer, one for each way a driver waits for it:
+ * song 1 returns from init and lets the GBS call play, song 2 halts in its
+ * own loop with interrupts on, and song 3 polls LY, TIMA and IF with them
+ * off, never returning.
+ */
+uint32_t synth_idle(struct synth_s *s){
+    enum { INIT, HALT, HALTLOOP, POLL, POLLLOOP, TIF, PLAY };
+
+    synth_start(s, 3, 0xC0, 0x04);
+    synth_label(s, INIT);
+    SYNTH(s, 0x47);                                         // ld b,a (the song)
+    SYNTH(s, 0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25);
+    SYNTH(s, 0x3E, 0xF0, 0xE0, 0x12, 0xE0, 0x17);
+    SYNTH(s, 0x78, 0xFE, 0x01);
+    synth_jr(s, 0x28, HALT);
+    SYNTH(s, 0xFE, 0x02);
+    synth_jr(s, 0x28, POLL);
+    SYNTH(s, 0xC9);
+
+    synth_label(s, HALT);
+    SYNTH(s, 0x3E, 0x04, 0xE0, 0xFF, 0xFB);                 // IE = timer; ei
+    synth_label(s, HALTLOOP);
+    SYNTH(s, 0x76);
+    synth_jr(s, 0x18, HALTLOOP);
+
+    synth_label(s, POLL);
+    SYNTH(s, 0x06, 0x00);
+    synth_label(s, POLLLOOP);
+    SYNTH(s, 0xF0, 0x44, 0xFE, 0x90, 0x20, 0xFA);           // wait for LY 90
+    SYNTH(s, 0x78, 0xE0, 0x13, 0x3E, 0x87, 0xE0, 0x14, 0x04);   // ch1 note b, inc b
+    SYNTH(s, 0xF0, 0x44, 0xFE, 0x90, 0x28, 0xFA);           // wait for LY not 90
+    SYNTH(s, 0xF0, 0x05, 0x4F);                             // wait for TIMA to move
+    SYNTH(s, 0xF0, 0x05, 0xB9, 0x28, 0xFB);
+    SYNTH(s, 0x78, 0xE0, 0x18, 0x3E, 0x87, 0xE0, 0x19);     // ch2 note b
+    synth_label(s, TIF);
+    SYNTH(s, 0xFA, 0x0F, 0xFF, 0xE6, 0x04);                 // wait for the timer flag
+    synth_abs(s, 0xCA, TIF);
+    SYNTH(s, 0xAF, 0xE0, 0x0F);
+    synth_jr(s, 0x18, POLLLOOP);
+
+    synth_label(s, PLAY);
+    SYNTH(s, 0xF0, 0x80, 0x3C, 0xE0, 0x80, 0xE0, 0x13, 0x3E, 0x87, 0xE0, 0x14);
+    SYNTH(s, 0xD9);                                         // reti, for song 2
+    return synth_end(s, s->label[INIT], s->label[PLAY]);
+}
+
+/**
+ * Init never returns: it switches ROM banks in bank 0 just below 0x4000
+ * and runs on into the bank it selected, bank 1 going straight back to
+ * select bank 2, which plays a note and waits before selecting bank 1.
+ */
+uint32_t synth_banks(struct synth_s *s){
+    enum { INIT, SWITCH, DELAY, PLAY };
+
+    synth_start(s, 1, 0, 0);
+    synth_label(s, INIT);
+    SYNTH(s, 0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25);
+    SYNTH(s, 0x3E, 0xF0, 0xE0, 0x12, 0x3E, 0x01);
+    synth_abs(s, 0xC3, SWITCH);
+    synth_label(s, PLAY);
+    SYNTH(s, 0xC9);
+
+    synth_org(s, 0, 0x3FF8);
+    synth_label(s, SWITCH);
+    SYNTH(s, 0xEA, 0x00, 0x20, 0x18, 0x00);                 // ld (2000),a; jr +0; on into 4000
+
+    synth_org(s, 1, 0x4000);
+    SYNTH(s, 0x3C);                                         // inc a
+    synth_jr(s, 0x18, SWITCH);
+
+    synth_org(s, 2, 0x4000);
+    SYNTH(s, 0xF0, 0x80, 0x3C, 0xE0, 0x80, 0xE0, 0x13, 0x3E, 0x87, 0xE0, 0x14);
+    SYNTH(s, 0x06, 0x00);
+    synth_label(s, DELAY);
+    SYNTH(s, 0x05);
+    synth_jr(s, 0x20, DELAY);
+    SYNTH(s, 0x3E, 0x01);
+    synth_jr(s, 0x18, SWITCH);
+    synth_org(s, 2, 0x8000);
+    return synth_end(s, s->label[INIT], s->label[PLAY]);
+}
+
+/**
+ * A random program of two songs over three banks: mostly loads, ALU ops
+ * and short branches, with sound register writes, RETs and CB prefixes
+ * mixed in, and bank switches if banks is true. Odd seeds are timer driven.
+ */
+uint32_t synth_random(struct synth_s *s, uint32_t seed, bool banks){
+    uint32_t r = seed * 2654435761u + 1;
+    uint32_t i;
+
+    synth_start(s, 2, 0, 0);
+    s->gbs[0x0E] = synth_rnd(&r);
+    s->gbs[0x0F] = (seed & 1) ? 0x04 | (synth_rnd(&r) & 3) : 0;
+    for(i = 0x70; i < SYNTH_SIZE; i++){
+        uint32_t n = synth_rnd(&r) % 16;
+
+        if(n < 2 && i + 1 < SYNTH_SIZE){
+            s->gbs[i] = 0xE0;                               // ldh (NRxx),a
+            s->gbs[++i] = 0x10 + synth_rnd(&r) % 0x17;
+        }else if(n == 2){
+            s->gbs[i] = 0xC9;
+        }else if(n == 3){
+            s->gbs[i] = 0xCB;
+        }else if(n == 4 && banks && i + 2 < SYNTH_SIZE){
+            s->gbs[i] = 0xEA;                               // ld (2000),a
+            s->gbs[++i] = 0x00;
+            s->gbs[++i] = 0x20;
+        }else{
+            s->gbs[i] = synth_rnd(&r);
+        }
+    }
+    s->size = SYNTH_SIZE;
+    return synth_end(s, SYNTH_LOAD, SYNTH_LOAD + 0x100);
+}
@@ -0,0 +1,46 @@
+/*
+ * Writes the synthetic GBS files of synth.h to a directory, for the golden
+ * output tests to render (see tests/CMakeLists.txt).
+ *
+ * Usage: synth_gbs dir
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "synth.h"
+
+static struct synth_s synth;
+
+static bool write_gbs(const char *dir, const char *name, uint32_t size){
+	char path[1024];
+	FILE *f;
+
+	if(!size){
+		fprintf(stderr, "%s: a jump does not reach its label\n", name);
+		return false;
+	}
+	snprintf(path, sizeof(path), "%s/%s.gbs", dir, name);
+	f = fopen(path, "wb");
+	if(!f || fwrite(synth.gbs, 1, size, f) != size){
+		perror(path);
+		if(f) fclose(f);
+		return false;
+	}
+	fclose(f);
+	return true;
+}
+
+int main(int argc, char **argv){
+	bool ok = true;
+
+	if(argc != 2){
+		fprintf(stderr, "Usage: %s dir\n", argv[0]);
+		return 1;
+	}
+	ok &= write_gbs(argv[1], "driver", synth_driver(&synth));
+	ok &= write_gbs(argv[1], "idle", synth_idle(&synth));
+	ok &= write_gbs(argv[1], "banks", synth_banks(&synth));
+	return ok ? 0 : 1;
+}